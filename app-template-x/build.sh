@@ -89,6 +89,8 @@ emcc "$MAIN_SRC" \
     -DVOLT_GUID=\"$GUID\" \
     -DDEBUG \
     -DVOLT_ENABLE_LOG \
+    -DVOLT_ENABLE_PROFILER \
+    -DVOLT_ENABLE_SPANS \
     -I./dependencies/volt/include \
     -o output/app.js \
     -lembind \
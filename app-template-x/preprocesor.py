@@ -10,7 +10,7 @@ Transforms these DSL forms inside C/C++ code:
 
    becomes:
 
-    (some_cpp_expression).track(__COUNTER__)
+    (some_cpp_expression).track(VOLT_KEY)
 
 2) Render-call form (functions ending in 'render' returning VNodeHandle):
 
@@ -19,8 +19,8 @@ Transforms these DSL forms inside C/C++ code:
 
    becomes:
 
-    MyComponent(this).render(1, 2).track(__COUNTER__)
-    this_is_my_function_render(3).track(__COUNTER__)
+    MyComponent(this).render(1, 2).track(VOLT_KEY)
+    this_is_my_function_render(3).track(VOLT_KEY)
 
 3) Map form:
 
@@ -28,7 +28,7 @@ Transforms these DSL forms inside C/C++ code:
 
    becomes:
 
-    volt::map(container, callback).track(__COUNTER__)
+    volt::map(container, callback).track(VOLT_KEY)
 
    The callback body is itself processed by the same DSL transformer,
    so you can write <.../> inside the map callback.
@@ -39,7 +39,7 @@ Transforms these DSL forms inside C/C++ code:
 
    becomes:
 
-    volt::tag::_fragment(child1, child2, ...).track(__COUNTER__)
+    volt::tag::_fragment(child1, child2, ...).track(VOLT_KEY)
 
    The inner content is also recursively processed as DSL.
 
@@ -51,8 +51,8 @@ Transforms these DSL forms inside C/C++ code:
 
     volt::tag::div(
         { volt::attr::style("color:red") },
-        (child).track(__COUNTER__)
-    ).track(__COUNTER__)
+        (child).track(VOLT_KEY)
+    ).track(VOLT_KEY)
 
    Props are rewritten from:
 
@@ -930,7 +930,7 @@ def expand_render_dsl(code: str, lt_pos: int, transform_nested) -> Optional[Tupl
     Returns (replacement_text, end_index_of_'>') or None on failure.
 
     The prefix before '<' is preserved by the caller, so we only
-    generate 'render(args).track(__COUNTER__)'.
+    generate 'render(args).track(VOLT_KEY)'.
     """
     if not code.startswith("<render(", lt_pos):
         return None
@@ -951,7 +951,7 @@ def expand_render_dsl(code: str, lt_pos: int, transform_nested) -> Optional[Tupl
         return None
 
     end_idx = slash_idx + 1
-    replacement = f"render({args}).track(__COUNTER__)"
+    replacement = f"render({args}).track(VOLT_KEY)"
     return replacement, end_idx
 
 
@@ -961,7 +961,7 @@ def expand_map_dsl(code: str, lt_pos: int, transform_nested) -> Optional[Tuple[s
 
         <map(container, callback)/>
 
-    →   volt::map(container, callback).track(__COUNTER__)
+    →   volt::map(container, callback).track(VOLT_KEY)
 
     'args' is recursively transformed so callback bodies can contain DSL.
     """
@@ -984,7 +984,7 @@ def expand_map_dsl(code: str, lt_pos: int, transform_nested) -> Optional[Tuple[s
         return None
 
     end_idx = slash_idx + 1
-    replacement = f"volt::map({args}).track(__COUNTER__)"
+    replacement = f"volt::map({args}).track(VOLT_KEY)"
     return replacement, end_idx
 
 
@@ -994,7 +994,7 @@ def expand_fragment_dsl(code: str, lt_pos: int, transform_nested) -> Optional[Tu
 
         <( child1, child2, ... )/>
 
-    →   volt::tag::_fragment(child1, child2, ...).track(__COUNTER__)
+    →   volt::tag::_fragment(child1, child2, ...).track(VOLT_KEY)
 
     Inner content is recursively transformed as DSL.
     """
@@ -1023,9 +1023,9 @@ def expand_fragment_dsl(code: str, lt_pos: int, transform_nested) -> Optional[Tu
 
     end_idx = slash_idx + 1
     if fragment_if:
-        replacement = f"volt::tag::_fragment_if(__COUNTER__, __COUNTER__,{inner})"
+        replacement = f"volt::tag::_fragment_if(VOLT_KEY, VOLT_KEY,{inner})"
     else:
-        replacement = f"volt::tag::_fragment({inner}).track(__COUNTER__)"
+        replacement = f"volt::tag::_fragment({inner}).track(VOLT_KEY)"
     return replacement, end_idx
 
 
@@ -1035,8 +1035,8 @@ def expand_tag_dsl(code: str, lt_pos: int, transform_nested) -> Optional[Tuple[s
 
         <div({ style:=("x") }, <:=(child)/>) />
 
-    →   volt::tag::div({ volt::attr::style("x") }, (child).track(__COUNTER__))
-         .track(__COUNTER__)
+    →   volt::tag::div({ volt::attr::style("x") }, (child).track(VOLT_KEY))
+         .track(VOLT_KEY)
 
     The 'args' are recursively transformed (for nested DSL) and then
     props (propname:=) are rewritten to volt::attr::propname().
@@ -1076,9 +1076,9 @@ def expand_tag_dsl(code: str, lt_pos: int, transform_nested) -> Optional[Tuple[s
 
     end_idx = slash_idx + 1
     if tag_if:
-        replacement = f"volt::tag::{tag_to_cpp_name(ident)}_if(__COUNTER__, __COUNTER__,{args})"
+        replacement = f"volt::tag::{tag_to_cpp_name(ident)}_if(VOLT_KEY, VOLT_KEY,{args})"
     else:
-        replacement = f"volt::tag::{tag_to_cpp_name(ident)}({args}).track(__COUNTER__)"
+        replacement = f"volt::tag::{tag_to_cpp_name(ident)}({args}).track(VOLT_KEY)"
     return replacement, end_idx
 
 
@@ -24,7 +24,7 @@ public:
 
             // COUNTER SECTION
             <h2("Counter")/>,
-            <p("Current value: " + std::to_string(counter))/>,
+            <p(fmt("Current value: {}", counter))/>,
 
             <div(
                 <(Button(
@@ -5,29 +5,49 @@
 using namespace volt;
 using namespace emscripten;
 
-std::unique_ptr<VoltEngine> g_voltEngine = nullptr;
+// One engine per mounted root id, all rendered in one shared animation frame
+std::unordered_map<std::string, std::unique_ptr<VoltEngine>> g_voltEngines;
 
 EMSCRIPTEN_BINDINGS(VOLT_APP_NAME_UNDERSCORE_module) {
     function("getVoltNamespace", &volt::config::getVoltNamespace);
     
     function("createVoltEngine", +[](std::string rootId) {
-        g_voltEngine = std::make_unique<VoltEngine>(rootId, "VOLT_APP_NAME_UNDERSCORE_module");
-        g_voltEngine->mountApp<VOLT_APP_NAME_CAMEL>();
+        auto& pEngine = g_voltEngines[rootId];
+        pEngine = std::make_unique<VoltEngine>(rootId, "VOLT_APP_NAME_UNDERSCORE_module");
+        pEngine->mountApp<VOLT_APP_NAME_CAMEL>();
+    });
+
+    function("destroyVoltEngine", +[](std::string rootId) {
+        g_voltEngines.erase(rootId);
     });
     
     function("invokeVoltBubbleEvent", +[](emscripten::val event) {
-        invokeBubbleEvent(event);
+        return invokeBubbleEvent(event);
+    });
+
+    function("flushVoltSync", +[]() {
+        flushSync();
     });
 
     function("invokeVoltNonBubbleEvent", +[](emscripten::val event) {
         invokeNonBubbleEvent(event);
     });
 
-    function("clearVoltFocussedElements", +[]() {
-        g_voltEngine->clearFocussedElements();
+    function("runVoltTasks", +[](int lane, double budgetMs) {
+        runScheduledTasks(lane, budgetMs);
+    });
+
+    function("clearVoltFocussedElements", +[](std::string rootId) {
+        auto it = g_voltEngines.find(rootId);
+        if (it != g_voltEngines.end()) {
+            it->second->clearFocussedElements();
+        }
     });
 
-    function("addVoltFocussedElement", +[](emscripten::val element) {
-        g_voltEngine->addFocussedElement(element);
+    function("setVoltFocussedNode", +[](std::string rootId, uint32_t nodeId) {
+        auto it = g_voltEngines.find(rootId);
+        if (it != g_voltEngines.end()) {
+            it->second->setFocussedNode(nodeId);
+        }
     });
 }
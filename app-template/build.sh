@@ -39,6 +39,8 @@ emcc src/main.cpp \
     -DVOLT_GUID=\"$GUID\" \
     -DDEBUG \
     -DVOLT_ENABLE_LOG \
+    -DVOLT_ENABLE_PROFILER \
+    -DVOLT_ENABLE_SPANS \
     -I./dependencies/volt/include \
     -o output/app.js \
     -lembind \
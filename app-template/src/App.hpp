@@ -1,6 +1,5 @@
 #pragma once
 #include <Volt.hpp>
-#define TRACK track(__COUNTER__)
 
 #include "components/Button.hpp"
 
@@ -17,14 +16,14 @@ public:
     
     VNodeHandle render() override {
         return tag::div({attr::style("font-family: sans-serif; padding: 20px;")},
-            tag::h1(message).TRACK,
-            tag::p("Counter: " + std::to_string(counter)).TRACK,
+            tag::h1(message).VOLT_TRACK,
+            tag::p(fmt("Counter: {}", counter)).VOLT_TRACK,
 
             // Using reusable Button component
             Button(runtime()).render("Increment", [this](emscripten::val e) {
                 log("Increment button clicked");
                 counter++;
-            }, "primary").TRACK,
+            }, "primary").VOLT_TRACK,
 
             tag::div(
                 x::iff(counter % 2 == 0, [this](){
@@ -46,14 +45,14 @@ public:
                                 log("Reset button clicked");
                                 counter = 0;
                             })
-                        }, "Reset").TRACK
+                        }, "Reset").VOLT_TRACK
                     };
                 }, []() {
                     return std::vector<VNodeHandle>{"No button for you!"};
                 })
-            ).TRACK,
+            ).VOLT_TRACK,
 
-            (counter > 5 ? tag::p({attr::style("color: red;")}, "Counter exceeded 5!").TRACK : tag::br().TRACK),
+            (counter > 5 ? tag::p({attr::style("color: red;")}, "Counter exceeded 5!").VOLT_TRACK : tag::br().VOLT_TRACK),
 
             map(std::vector<std::string>{"Apple"}, [this](const std::string& fruit) {
                 return tag::_fragment({ attr::key(fruit) },
@@ -76,28 +75,28 @@ public:
                             attr::onRemoveElement([this](emscripten::val e) {
                                 log("onRemoveElement article");
                             })},
-                        tag::h1(fruit).TRACK,
-                        tag::br().TRACK,
-                        tag::a({attr::href("https://example.com/" + fruit)}, fruit).TRACK,
+                        tag::h1(fruit).VOLT_TRACK,
+                        tag::br().VOLT_TRACK,
+                        tag::a({attr::href("https://example.com/" + fruit)}, fruit).VOLT_TRACK,
                         map(std::vector<int>{0}, [fruit](int num) {
                             std::vector<VNodeHandle> lines;
                             for (int i = 0; i < 20; i++) {
-                                lines.push_back(tag::span({attr::id("fruit-" + fruit + "-line-span-" + std::to_string(i))}, " - " + fruit + " #" + std::to_string(i) + " ").TRACK);
-                                lines.push_back(tag::br({attr::id("fruit-" + fruit + "-line-br-" + std::to_string(i))}).TRACK);
+                                lines.push_back(tag::span({attr::id("fruit-" + fruit + "-line-span-" + std::to_string(i))}, " - " + fruit + " #" + std::to_string(i) + " ").VOLT_TRACK);
+                                lines.push_back(tag::br({attr::id("fruit-" + fruit + "-line-br-" + std::to_string(i))}).VOLT_TRACK);
                             }
                             for (int i = 0; i < 20; i++) {
                                 lines.push_back(
                                     tag::_fragment({attr::key("fruit-" + fruit + "-fragment-" + std::to_string(i))},
-                                        tag::span("in fragment - " + fruit + " #" + std::to_string(i) + " ").TRACK,
-                                        tag::br().TRACK
-                                    ).TRACK
+                                        tag::span("in fragment - " + fruit + " #" + std::to_string(i) + " ").VOLT_TRACK,
+                                        tag::br().VOLT_TRACK
+                                    ).VOLT_TRACK
                                 );
                             }
-                            return tag::_fragment(lines).TRACK;
-                        }).TRACK
-                    ).TRACK
-                ).TRACK;
-            }).TRACK
-        ).TRACK;
+                            return tag::_fragment(lines).VOLT_TRACK;
+                        }).VOLT_TRACK
+                    ).VOLT_TRACK
+                ).VOLT_TRACK;
+            }).VOLT_TRACK
+        ).VOLT_TRACK;
     }
 };
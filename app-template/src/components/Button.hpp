@@ -1,6 +1,5 @@
 #pragma once
 #include <Volt.hpp>
-#define TRACK track(__COUNTER__)
 
 using namespace volt;
 
@@ -33,6 +32,6 @@ public:
         return tag::button({
             attr::style(baseStyle + variantStyle),
             attr::onClick(onButtonClick)
-        }, label).TRACK;
+        }, label).VOLT_TRACK;
     }
 };
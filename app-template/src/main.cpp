@@ -15,8 +15,14 @@ EMSCRIPTEN_BINDINGS(VOLT_APP_NAME_UNDERSCORE_module) {
         g_runtime->mountApp<VOLT_APP_NAME_CAMEL>();
     });
     
-    function("invokeBubbleEvent", +[](intptr_t __cpp_ptr_as_int, emscripten::val event) {
-        VNode* pVNode = reinterpret_cast<volt::VNode*>(__cpp_ptr_as_int);
-        (void)pVNode->bubbleCallback(event["type"].as<std::string>(), event);
-    }, emscripten::allow_raw_pointers());
+    function("invokeBubbleEvent", +[](uint32_t a_nNodeId, emscripten::val event) {
+        VNode* pVNode = VNodeTable::instance().find(a_nNodeId);
+        if (pVNode != nullptr) {
+            (void)pVNode->bubbleCallback(event["type"].as<std::string>(), event);
+        }
+    });
+
+    function("runVoltTasks", +[](int lane, double budgetMs) {
+        runScheduledTasks(lane, budgetMs);
+    });
 }
@@ -0,0 +1,329 @@
+// ============================================================================
+// Volt native microbenchmarks
+// ============================================================================
+// The non-DOM core (key building, id stores, VNode construction,
+// prop sorting, fragment flattening) compiled for the host against the stubs in stub/.
+// See README.md for building and reading the results.
+//
+// Usage: volt_bench [name filter]
+
+#include <variant>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <Volt.hpp>
+#include "VoltBench.hpp"
+
+using namespace volt;
+using volt::bench::Measurement;
+using volt::bench::Runner;
+using volt::bench::doNotOptimize;
+
+namespace {
+
+// ============================================================================
+// Fixtures
+// ============================================================================
+
+// Ids shaped like the ones the reconciler stores: nested positions and a keyed list item
+std::vector<std::string> makeIds(size_t a_nCount) {
+    std::vector<std::string> ids;
+    ids.reserve(a_nCount);
+    for (size_t i = 0; i < a_nCount; ++i) {
+        ids.push_back("I0_I3_I" + std::to_string(i % 7) + "_Sitem-" + std::to_string(i) + "_I0_");
+    }
+    return ids;
+}
+
+// Stored but never dereferenced by the id stores
+VNode* fakeNode(size_t a_nIdx) {
+    return reinterpret_cast<VNode*>((a_nIdx + 1) * alignof(VNode));
+}
+
+// Runs one frame of a mounted engine, whatever the app renders is measured by the app itself
+std::function<VNodeHandle()> g_fnRender;
+
+class BenchApp : public App {
+public:
+    BenchApp(IRuntime& a_runtime) : App(a_runtime) {}
+    VNodeHandle render() override { return g_fnRender ? g_fnRender() : tag::div().track(0); }
+};
+
+void runFrame(VoltEngine& a_engine) {
+    a_engine.invalidate();
+    volt_stub::runAnimationFrame();
+}
+
+// Renders through the engine so VNodes come from its pool, as in a real frame.
+// Only a_fnBuild is measured, the reconcile of the (empty) result is not.
+template<typename Build>
+void runInRender(Runner& a_runner, VoltEngine& a_engine, const std::string& a_sName, size_t a_nOps, Build a_fnBuild) {
+    a_runner.runRegions(a_sName, [&](Measurement& a_measurement) {
+        g_fnRender = [&]() {
+            a_measurement.begin();
+            a_fnBuild();
+            a_measurement.end(a_nOps);
+            return tag::div().track(0);
+        };
+        runFrame(a_engine);
+        g_fnRender = nullptr;
+    });
+}
+
+// ============================================================================
+// IdManager::StableKeyBuilder
+// ============================================================================
+
+void benchKeyBuilder(Runner& a_runner) {
+    for (int nDepth : {4, 16, 64}) {
+        std::vector<std::string> tokens;
+        for (int i = 0; i < nDepth; ++i) {
+            tokens.push_back("I" + std::to_string(i % 10) + "_");
+        }
+        IdManager::StableKeyBuilder builder;
+        // One op: push a token, build the key at that depth; then all tokens are popped
+        a_runner.run("key_builder/push_build_pop/depth=" + std::to_string(nDepth), nDepth, [&]() {
+            for (const std::string& sToken : tokens) {
+                builder.pushString(sToken);
+                doNotOptimize(builder.build());
+            }
+            for (int i = 0; i < nDepth; ++i) {
+                builder.popToken();
+            }
+        });
+    }
+
+    // A keyed item lifted out of a loop() fragment into a <ul>
+    VNode list(tag::ETag::ul);
+    VNode fragment(tag::ETag::_FRAGMENT);
+    fragment.setStableKey(2);
+    fragment.setFlattenedInto(&list);
+    VNode keyed(tag::ETag::li);
+    keyed.setKeyProp("item-42");
+    keyed.setPrefixFragment(&fragment);
+    VNode positioned(tag::ETag::div);
+    positioned.setStableKey(3);
+    VNode tracked(tag::ETag::div);
+    tracked.setStableKey(VOLT_KEY);
+    VNode withId(tag::ETag::section);
+    withId.setIdProp("sidebar");
+
+    IdManager::StableKeyBuilder builder;
+    builder.pushString("I0_I1_I4_");
+    for (auto [sName, pNode] : { std::pair<const char*, VNode*>{"key", &keyed}, {"index", &positioned}, {"compile_time", &tracked}, {"id", &withId} }) {
+        a_runner.run(std::string("key_builder/vnode_token/") + sName, 1, [&]() {
+            builder.pushVNodeToken(pNode);
+            doNotOptimize(builder.build());
+            builder.popToken();
+        });
+    }
+}
+
+// ============================================================================
+// IdManager::findVNode / addVNode
+// ============================================================================
+
+void benchIdStore(Runner& a_runner) {
+    std::mt19937 random(42);
+    for (size_t nCount : {64, 1024, 16384, 262144}) {
+        std::vector<std::string> ids = makeIds(nCount);
+        std::string sSize = "/n=" + std::to_string(nCount);
+
+        // One frame's worth of nodes into a store that kept its buckets
+        IdManager idManager;
+        a_runner.run("id_store/add" + sSize, nCount, [&]() {
+            idManager.startGeneration(nCount);
+            for (size_t i = 0; i < nCount; ++i) {
+                idManager.addVNode(ids[i], fakeNode(i));
+            }
+        });
+
+        // Lookups of the previous frame's nodes, in tree order and in random order
+        idManager.startGeneration(nCount);
+        std::vector<size_t> order(nCount);
+        for (size_t i = 0; i < nCount; ++i) {
+            order[i] = i;
+        }
+        a_runner.run("id_store/find_in_order" + sSize, nCount, [&]() {
+            for (size_t nIdx : order) {
+                doNotOptimize(idManager.findVNode(ids[nIdx]));
+            }
+        });
+        std::shuffle(order.begin(), order.end(), random);
+        a_runner.run("id_store/find_shuffled" + sSize, nCount, [&]() {
+            for (size_t nIdx : order) {
+                doNotOptimize(idManager.findVNode(ids[nIdx]));
+            }
+        });
+    }
+}
+
+// ============================================================================
+// VNodeHandle construction
+// ============================================================================
+
+struct Row {
+    void onClick(int, emscripten::val) {}
+    void onHover(emscripten::val) {}
+};
+
+void benchVNodeHandle(Runner& a_runner, VoltEngine& a_engine) {
+    const size_t nCount = 1000;
+    std::vector<std::string> keys = makeIds(nCount);
+    std::vector<VNodeHandle> built;
+    built.reserve(nCount);
+    Row row;
+
+    // One op: one tag helper call, children included
+    runInRender(a_runner, a_engine, "vnode_handle/text", nCount, [&]() {
+        built.clear();
+        for (size_t i = 0; i < nCount; ++i) {
+            built.push_back(tag::span("label"));
+        }
+    });
+
+    runInRender(a_runner, a_engine, "vnode_handle/props4", nCount, [&]() {
+        built.clear();
+        for (size_t i = 0; i < nCount; ++i) {
+            built.push_back(tag::div({
+                attr::key(keys[i]),
+                attr::classtoken("row"),
+                attr::classtoken_if(i % 3 == 0, "selected"),
+                attr::styleprop("width", "40%"),
+            }, tag::span("label")));
+        }
+    });
+
+    runInRender(a_runner, a_engine, "vnode_handle/props_lambdas", nCount, [&]() {
+        built.clear();
+        for (size_t i = 0; i < nCount; ++i) {
+            built.push_back(tag::button({
+                attr::classtoken("btn"),
+                attr::title("Open"),
+                attr::onclick([pRow = &row, i](emscripten::val a_event) { pRow->onClick(static_cast<int>(i), a_event); }),
+                attr::onmouseenter([pRow = &row](emscripten::val a_event) { pRow->onHover(a_event); }),
+                attr::onfocus([](emscripten::val) {}),
+            }, "Open"));
+        }
+    });
+    built.clear();
+}
+
+// ============================================================================
+// VNode::setProps
+// ============================================================================
+
+void benchSetProps(Runner& a_runner) {
+    std::mt19937 random(7);
+    const short attrIds[] = {
+        attr::ATTR_id, attr::ATTR_title, attr::ATTR_href, attr::ATTR_type, attr::ATTR_name, attr::ATTR_value,
+        attr::ATTR_placeholder, attr::ATTR_alt, attr::ATTR_src, attr::ATTR_role, attr::ATTR_tabindex, attr::ATTR_target,
+        attr::ATTR_disabled, attr::ATTR_checked, attr::ATTR_hidden, attr::ATTR_width,
+    };
+    VNode node(tag::ETag::div);
+    for (size_t nCount : {2, 4, 8, 16}) {
+        std::vector<std::pair<short, std::string>> props;
+        for (size_t i = 0; i < nCount; ++i) {
+            props.push_back({attrIds[i], "value-" + std::to_string(i)});
+        }
+        std::shuffle(props.begin(), props.end(), random);
+        // One op: a copy of the props handed to setProps, as VNodeHandle's vector overload does
+        a_runner.run("vnode/set_props/n=" + std::to_string(nCount), 1, [&]() {
+            node.setProps(props);
+            doNotOptimize(node.getProps().data());
+        });
+    }
+}
+
+// ============================================================================
+// Fragment flattening
+// ============================================================================
+
+// a_nDepth fragments around a keyed list, every level flattens the whole list again
+VNodeHandle nestFragments(int a_nDepth, int a_nLeaves, const std::vector<std::string>& a_keys) {
+    if (a_nDepth == 0) {
+        return loop(a_nLeaves, [&](size_t i) { return tag::li({attr::key(a_keys[i])}, "item"); });
+    }
+    return tag::_fragment(nestFragments(a_nDepth - 1, a_nLeaves, a_keys)).track(a_nDepth);
+}
+
+void benchFragments(Runner& a_runner, VoltEngine& a_engine) {
+    const int nLeaves = 16;
+    std::vector<std::string> keys = makeIds(nLeaves);
+    for (int nDepth : {1, 4, 16}) {
+        // One op: one leaf lifted out of one fragment (a concatIds of its prefix)
+        runInRender(a_runner, a_engine, "fragments/flatten/depth=" + std::to_string(nDepth), nLeaves * nDepth, [&]() {
+            VNodeHandle parent = tag::ul(nestFragments(nDepth, nLeaves, keys));
+            doNotOptimize(parent.getNodePtr());
+        });
+    }
+}
+
+// ============================================================================
+// Number text
+// ============================================================================
+
+// A grid of numbers of which a_nChangedEvery-th cell changes per frame, rendered and reconciled
+void benchNumberText(Runner& a_runner, VoltEngine& a_engine) {
+    const size_t nCells = 1000;
+    std::vector<int> values(nCells);
+    for (size_t i = 0; i < nCells; ++i) {
+        values[i] = static_cast<int>(i * 37);
+    }
+    size_t nFrame = 0;
+
+    auto changeSome = [&]() {
+        ++nFrame;
+        for (size_t i = nFrame % 10; i < nCells; i += 10) {
+            ++values[i];
+        }
+    };
+
+    // One op: one cell built and diffed in a whole frame, one in ten changed
+    g_fnRender = [&]() {
+        std::vector<VNodeHandle> cells;
+        cells.reserve(nCells);
+        for (size_t i = 0; i < nCells; ++i) {
+            cells.push_back(tag::td("Throughput: " + std::to_string(values[i]) + " req/s").track(static_cast<int>(i)));
+        }
+        return tag::tr(std::move(cells)).track(0);
+    };
+    runFrame(a_engine);
+    a_runner.run("number_text/frame/to_string", nCells, [&]() { changeSome(); runFrame(a_engine); });
+
+    g_fnRender = [&]() {
+        std::vector<VNodeHandle> cells;
+        cells.reserve(nCells);
+        for (size_t i = 0; i < nCells; ++i) {
+            cells.push_back(tag::td(fmt("Throughput: {} req/s", values[i])).track(static_cast<int>(i)));
+        }
+        return tag::tr(std::move(cells)).track(0);
+    };
+    runFrame(a_engine);
+    a_runner.run("number_text/frame/fmt", nCells, [&]() { changeSome(); runFrame(a_engine); });
+
+    g_fnRender = nullptr;
+    runFrame(a_engine);
+}
+
+} // namespace
+
+int main(int a_nArgc, char** a_argv) {
+    Runner runner(a_nArgc > 1 ? a_argv[1] : "");
+    if (!runner.getCounters().isAvailable(volt::bench::PerfCounters::CYCLES)) {
+        std::printf("Hardware counters unavailable (see /proc/sys/kernel/perf_event_paranoid), timing only\n\n");
+    }
+    Measurement::printHeader();
+
+    benchKeyBuilder(runner);
+    benchIdStore(runner);
+    benchSetProps(runner);
+
+    VoltEngine engine("root", "bench");
+    engine.mountApp<BenchApp>();
+    runFrame(engine);
+    benchVNodeHandle(runner, engine);
+    benchFragments(runner, engine);
+    benchNumberText(runner, engine);
+    return 0;
+}
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+// Minimum measured time per benchmark, e.g. -DVOLT_BENCH_MIN_MS=500
+#ifndef VOLT_BENCH_MIN_MS
+#define VOLT_BENCH_MIN_MS 200.0
+#endif
+
+namespace volt::bench {
+
+// ============================================================================
+// PerfCounters - Hardware counters of this thread, read as one group
+// ============================================================================
+// Uses perf_event_open. Counters the kernel refuses (perf_event_paranoid,
+// containers, VMs without a PMU) read as unavailable, timing still works.
+
+class PerfCounters {
+public:
+    enum ECounter { CYCLES, INSTRUCTIONS, CACHE_REFERENCES, CACHE_MISSES, L1D_READ_MISSES, BRANCH_MISSES, COUNT };
+
+    struct Sample {
+        uint64_t values[COUNT] = {};
+    };
+
+    PerfCounters() {
+#if defined(__linux__)
+        const std::pair<uint32_t, uint64_t> events[COUNT] = {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+            { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+                                  | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                  | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        };
+        for (int i = 0; i < COUNT; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = events[i].first;
+            attr.config = events[i].second;
+            attr.disabled = m_nLeaderFd < 0 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+            int nFd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, m_nLeaderFd, 0));
+            if (nFd < 0) {
+                continue; // Unavailable on this machine
+            }
+            if (m_nLeaderFd < 0) {
+                m_nLeaderFd = nFd;
+            }
+            uint64_t nId = 0;
+            ioctl(nFd, PERF_EVENT_IOC_ID, &nId);
+            m_counters.push_back({ static_cast<ECounter>(i), nFd, nId });
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (const Counter& counter : m_counters) {
+            close(counter.nFd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool isAvailable(ECounter a_nCounter) const {
+        for (const Counter& counter : m_counters) {
+            if (counter.nCounter == a_nCounter) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void start() {
+#if defined(__linux__)
+        if (m_nLeaderFd >= 0) {
+            ioctl(m_nLeaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    void stop() {
+#if defined(__linux__)
+        if (m_nLeaderFd >= 0) {
+            ioctl(m_nLeaderFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    // Totals since the counters were opened
+    Sample read() const {
+        Sample sample;
+#if defined(__linux__)
+        if (m_nLeaderFd < 0) {
+            return sample;
+        }
+        // { nr, { value, id } * nr }
+        uint64_t buffer[1 + 2 * COUNT] = {};
+        if (::read(m_nLeaderFd, buffer, sizeof(buffer)) <= 0) {
+            return sample;
+        }
+        for (uint64_t i = 0; i < buffer[0] && i < COUNT; ++i) {
+            for (const Counter& counter : m_counters) {
+                if (counter.nId == buffer[2 + 2 * i]) {
+                    sample.values[counter.nCounter] = buffer[1 + 2 * i];
+                }
+            }
+        }
+#endif
+        return sample;
+    }
+
+private:
+    struct Counter {
+        ECounter nCounter;
+        int nFd;
+        uint64_t nId;
+    };
+
+    int m_nLeaderFd = -1;
+    std::vector<Counter> m_counters;
+};
+
+// ============================================================================
+// Measurement - Time and counters of the regions between begin() and end()
+// ============================================================================
+// Regions can be spread over several calls, e.g. only the render part of a
+// frame. Only what runs inside a region is counted.
+
+class Measurement {
+public:
+    explicit Measurement(PerfCounters& a_counters) : m_counters(a_counters) {}
+
+    void begin() {
+        m_startSample = m_counters.read();
+        m_counters.start();
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    void end(size_t a_nOps) {
+        auto stop = std::chrono::steady_clock::now();
+        m_counters.stop();
+        PerfCounters::Sample sample = m_counters.read();
+        for (int i = 0; i < PerfCounters::COUNT; ++i) {
+            m_total.values[i] += sample.values[i] - m_startSample.values[i];
+        }
+        m_nNs += std::chrono::duration<double, std::nano>(stop - m_start).count();
+        m_nOps += a_nOps;
+    }
+
+    void reset() {
+        m_total = PerfCounters::Sample();
+        m_nNs = 0;
+        m_nOps = 0;
+    }
+
+    double elapsedMs() const { return m_nNs / 1e6; }
+    size_t ops() const { return m_nOps; }
+
+    void report(const std::string& a_sName) const {
+        double nOps = m_nOps > 0 ? static_cast<double>(m_nOps) : 1.0;
+        std::printf("%-44s %10.1f", a_sName.c_str(), m_nNs / nOps);
+        const PerfCounters::ECounter columns[] = {
+            PerfCounters::CYCLES, PerfCounters::INSTRUCTIONS, PerfCounters::CACHE_MISSES,
+            PerfCounters::L1D_READ_MISSES, PerfCounters::BRANCH_MISSES,
+        };
+        for (PerfCounters::ECounter nCounter : columns) {
+            if (m_counters.isAvailable(nCounter)) {
+                std::printf(" %11.2f", static_cast<double>(m_total.values[nCounter]) / nOps);
+            } else {
+                std::printf(" %11s", "-");
+            }
+        }
+        std::printf("\n");
+    }
+
+    static void printHeader() {
+        std::printf("%-44s %10s %11s %11s %11s %11s %11s\n",
+            "benchmark", "ns/op", "cycles/op", "instr/op", "llc-miss/op", "l1d-miss/op", "br-miss/op");
+    }
+
+private:
+    PerfCounters& m_counters;
+    PerfCounters::Sample m_startSample;
+    PerfCounters::Sample m_total;
+    std::chrono::steady_clock::time_point m_start;
+    double m_nNs = 0;
+    size_t m_nOps = 0;
+};
+
+// ============================================================================
+// Runner
+// ============================================================================
+
+class Runner {
+public:
+    // Only benchmarks whose name contains a_sFilter run
+    explicit Runner(std::string a_sFilter) : m_sFilter(std::move(a_sFilter)) {}
+
+    bool isSelected(const std::string& a_sName) const {
+        return m_sFilter.empty() || a_sName.find(m_sFilter) != std::string::npos;
+    }
+
+    PerfCounters& getCounters() { return m_counters; }
+
+    // Calls a_fn(measurement) after one warm-up call until VOLT_BENCH_MIN_MS is measured.
+    // a_fn marks what to measure with begin() / end(ops) itself.
+    template<typename Fn>
+    void runRegions(const std::string& a_sName, Fn&& a_fn) {
+        if (!isSelected(a_sName)) {
+            return;
+        }
+        Measurement measurement(m_counters);
+        a_fn(measurement);
+        measurement.reset();
+        while (measurement.elapsedMs() < VOLT_BENCH_MIN_MS || measurement.ops() == 0) {
+            a_fn(measurement);
+        }
+        measurement.report(a_sName);
+    }
+
+    // Measures a_fn as a whole, each call counts as a_nOps operations
+    template<typename Fn>
+    void run(const std::string& a_sName, size_t a_nOps, Fn&& a_fn) {
+        runRegions(a_sName, [&](Measurement& a_measurement) {
+            a_measurement.begin();
+            a_fn();
+            a_measurement.end(a_nOps);
+        });
+    }
+
+private:
+    std::string m_sFilter;
+    PerfCounters m_counters;
+};
+
+// Keeps the optimizer from discarding a result
+template<typename T>
+inline void doNotOptimize(T const& a_value) {
+    asm volatile("" : : "g"(&a_value) : "memory");
+}
+
+} // namespace volt::bench
@@ -0,0 +1,430 @@
+// ============================================================================
+// Volt patch buffer check, native half
+// ============================================================================
+// Makes one frame of DOM writes twice against the recording DOM in domstub/:
+// through the patch buffer on one subtree, right away on a twin subtree. The
+// patch is not applied here, it is dumped as JSON for VoltPatchCheck.js:
+// records, handle ids, names, string arena, the DOM the handles point at and
+// the twin's state, which the patch must produce. VoltPatchCheck.js applies
+// it with volt.js from a simulated MEMORY64 heap and through a worker.
+//
+// Usage: volt_patch_check <dump.json>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <set>
+#include <Volt.hpp>
+#include <DomStub.hpp>
+
+using namespace volt;
+using volt_stub::Object;
+
+namespace {
+
+// ============================================================================
+// Scene
+// ============================================================================
+
+struct Scene {
+    emscripten::val hHost;
+    emscripten::val hTitle, hTitleText;     // h1 with a text node
+    emscripten::val hInput, hCheckbox;      // value and checked properties
+    emscripten::val hBox;                   // attribute, style and class writes
+    emscripten::val hDetails;               // boolean attribute
+    emscripten::val hPanel;                 // scroll offsets
+    emscripten::val hList, hFirst, hSecond, hThird;
+};
+
+emscripten::val handler(const char* a_sName) {
+    return emscripten::val::module_property(a_sName);
+}
+
+emscripten::val element(tag::ETag a_nTag, const emscripten::val& a_hParent) {
+    emscripten::val hElement = dom::createElement(a_nTag);
+    dom::appendChild(a_hParent, hElement);
+    return hElement;
+}
+
+// Same starting DOM on both sides, written right away
+Scene setup(const std::string& a_sId) {
+    Scene scene;
+    scene.hHost = dom::createElement(tag::ETag::div);
+    dom::setAttribute(scene.hHost, std::string("id"), a_sId);
+    dom::appendChild(emscripten::val::global("document")["body"], scene.hHost);
+
+    scene.hTitle = element(tag::ETag::h1, scene.hHost);
+    scene.hTitleText = dom::createTextNode("Old title");
+    dom::appendChild(scene.hTitle, scene.hTitleText);
+
+    scene.hInput = element(tag::ETag::input, scene.hHost);
+    dom::setAttribute(scene.hInput, attr::ATTR_value, "old");
+    scene.hCheckbox = element(tag::ETag::input, scene.hHost);
+    dom::setAttribute(scene.hCheckbox, attr::ATTR_checked, "true");
+
+    scene.hBox = element(tag::ETag::div, scene.hHost);
+    dom::setAttribute(scene.hBox, attr::ATTR_title, "box");
+    dom::setAttribute(scene.hBox, attr::ATTR_placeholder, "gone soon");
+    dom::addClass(scene.hBox["classList"], "keep");
+    dom::addClass(scene.hBox["classList"], "drop");
+    dom::setStyleProperty(scene.hBox["style"], "color", "red");
+    dom::addEventListener(scene.hBox, attr::ATTR_EVT_onscroll, handler("onBoxScroll"));
+
+    scene.hDetails = element(tag::ETag::details, scene.hHost);
+    dom::setAttribute(scene.hDetails, attr::ATTR_open, "true");
+
+    scene.hPanel = element(tag::ETag::section, scene.hHost);
+    dom::setAttribute(scene.hPanel, attr::ATTR_scrollleft, "40");
+
+    scene.hList = element(tag::ETag::ul, scene.hHost);
+    scene.hFirst = element(tag::ETag::li, scene.hList);
+    dom::appendChild(scene.hFirst, dom::createTextNode("first"));
+    scene.hSecond = element(tag::ETag::li, scene.hList);
+    dom::appendChild(scene.hSecond, dom::createTextNode("second"));
+    scene.hThird = element(tag::ETag::li, scene.hList);
+    dom::appendChild(scene.hThird, dom::createTextNode("third"));
+    return scene;
+}
+
+// The frame, recorded into the patch buffer when one is active. Writes to
+// several elements interleave so handle slots are not only reused in a row.
+void writeFrame(const Scene& a_scene) {
+    dom::setNodeValue(a_scene.hTitleText, "New title, caf\xC3\xA9 \xE2\x9C\x93 & <more> than sixteen bytes");
+    dom::setAttribute(a_scene.hBox, attr::ATTR_title, "a < b & \"c\" \xC3\xBC");
+    dom::setAttribute(a_scene.hInput, attr::ATTR_value, "typed");
+    dom::setAttribute(a_scene.hInput, attr::ATTR_value, "typed"); // Live value matches, skipped
+    dom::removeAttribute(a_scene.hBox, attr::ATTR_placeholder);
+    dom::setAttribute(a_scene.hCheckbox, attr::ATTR_checked, "false");
+    dom::setAttribute(a_scene.hDetails, attr::ATTR_open, "false");
+    dom::setAttribute(a_scene.hPanel, attr::ATTR_disabled, "true");
+
+    dom::addClass(a_scene.hBox["classList"], "added");
+    dom::removeClass(a_scene.hBox["classList"], "drop");
+    dom::setStyleProperty(a_scene.hBox["style"], "width", "50%");
+    dom::removeStyleProperty(a_scene.hBox["style"], "color");
+    dom::setAttribute(a_scene.hTitle, attr::ATTR_style, "margin: 2px; color: blue");
+
+    dom::setAttribute(a_scene.hPanel, attr::ATTR_scrolltop, "120");
+    dom::removeAttribute(a_scene.hPanel, attr::ATTR_scrollleft);
+    dom::removeAttribute(a_scene.hInput, attr::ATTR_value);
+    dom::setAttribute(a_scene.hInput, attr::ATTR_value, "again");
+    dom::removeAttribute(a_scene.hCheckbox, attr::ATTR_checked);
+
+    dom::removeEventListener(a_scene.hBox, attr::ATTR_EVT_onscroll, handler("onBoxScroll"));
+    dom::addEventListener(a_scene.hBox, attr::ATTR_EVT_onclick, handler("onBoxClick"));
+
+    // New element with children, a move and a removal
+    emscripten::val hFourth = dom::createElement(tag::ETag::li);
+    dom::setAttribute(hFourth, attr::ATTR_classname, "new");
+    dom::appendChild(hFourth, dom::createTextNode("fourth"));
+    dom::appendChild(a_scene.hList, hFourth);
+    dom::insertBefore(a_scene.hList, a_scene.hThird, a_scene.hFirst);
+    dom::removeChild(a_scene.hList, a_scene.hSecond);
+    dom::setNodeValue(a_scene.hTitleText, "Final title");
+
+    // volt::String values: several JS string handles between the element handles,
+    // one of them used on two elements with other handles in between
+    String sShared("shared \xE2\x9C\x93");
+    String sTyped("from js");
+    dom::setAttribute(a_scene.hFirst, attr::ATTR_title, sShared.toVal());
+    dom::setAttribute(a_scene.hInput, attr::ATTR_value, sTyped.toVal());
+    dom::setAttribute(a_scene.hPanel, attr::ATTR_style, String("color: green; padding: 1px").toVal());
+    dom::setAttribute(a_scene.hThird, attr::ATTR_title, sShared.toVal());
+    emscripten::val hFifth = dom::createElement(tag::ETag::li);
+    emscripten::val hFifthText = dom::createTextNode("");
+    dom::appendChild(hFifth, hFifthText);
+    dom::setNodeValue(hFifthText, (sShared + String(" & more")).toVal());
+    dom::setAttribute(a_scene.hInput, attr::ATTR_value, sTyped.toVal()); // Same handle, skipped
+    dom::appendChild(a_scene.hList, hFifth);
+}
+
+// ============================================================================
+// State
+// ============================================================================
+// Markup as in domstub, plus own properties (.name=value) and listeners
+// (@type=handler), sorted. VoltPatchCheck.js serializes the same way.
+
+void appendState(std::string& a_sOut, const Object& a_node) {
+    if (a_node.nKind == Object::TEXT) {
+        volt_stub::appendEscaped(a_sOut, a_node.sNodeValue, false);
+        return;
+    }
+    std::string sMarkup;
+    Object shallow = a_node;
+    shallow.children.clear();
+    volt_stub::appendMarkup(sMarkup, shallow);
+    sMarkup.resize(sMarkup.size() - (a_node.sName.size() + 4)); // "></tag>"
+    a_sOut += sMarkup;
+
+    for (const auto& [sName, value] : a_node.properties) {
+        if (sName.rfind("__", 0) != 0) {
+            a_sOut += " ." + sName + "=\"";
+            volt_stub::appendEscaped(a_sOut, volt_stub::toString(value), true);
+            a_sOut += '"';
+        }
+    }
+    std::vector<std::string> listeners;
+    for (const auto& [sType, pHandler] : a_node.listeners) {
+        listeners.push_back(sType + "=" + (pHandler ? pHandler->sName : std::string("?")));
+    }
+    std::sort(listeners.begin(), listeners.end());
+    for (const std::string& sListener : listeners) {
+        a_sOut += " @" + sListener;
+    }
+    a_sOut += '>';
+    for (const auto& pChild : a_node.children) {
+        appendState(a_sOut, *pChild);
+    }
+    a_sOut += "</" + a_node.sName + ">";
+}
+
+std::string childrenState(const Object& a_node) {
+    std::string sState;
+    for (const auto& pChild : a_node.children) {
+        appendState(sState, *pChild);
+    }
+    return sState;
+}
+
+const Object& objectOf(const emscripten::val& a_hValue) {
+    return *a_hValue.value().pObject;
+}
+
+// ============================================================================
+// Dump
+// ============================================================================
+
+std::string json(std::string_view a_sText) {
+    std::string sOut = "\"";
+    for (unsigned char c : a_sText) {
+        switch (c) {
+            case '"':  sOut += "\\\""; break;
+            case '\\': sOut += "\\\\"; break;
+            case '\n': sOut += "\\n"; break;
+            default:
+                if (c < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    sOut += buffer;
+                } else {
+                    sOut += static_cast<char>(c);
+                }
+        }
+    }
+    return sOut + "\"";
+}
+
+std::string json(const volt_stub::Value& a_value) {
+    switch (a_value.nType) {
+        case volt_stub::Value::BOOLEAN: return a_value.fNumber != 0 ? "true" : "false";
+        case volt_stub::Value::NUMBER:  return volt_stub::numberToString(a_value.fNumber);
+        case volt_stub::Value::STRING:  return json(a_value.sString);
+        default:                        return "null";
+    }
+}
+
+// Operand count per opcode, index = EPatchOp
+constexpr int RECORD_SIZE[] = {0, 5, 5, 4, 4, 4, 3, 6, 4, 4, 4, 4, 3, 4, 3, 4, 4, 4, 4, 3, 3, 5};
+constexpr int OP_COUNT = static_cast<int>(sizeof(RECORD_SIZE) / sizeof(RECORD_SIZE[0]));
+
+// Opcodes the frame must use, each is applied by VoltPatchCheck.js
+const std::set<int> REQUIRED_OPS = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21};
+
+class Dumper {
+public:
+    Dumper(const Object* a_pHost, std::string a_sExpected) : m_pHost(a_pHost), m_sExpected(std::move(a_sExpected)) {}
+
+    // The patch hook: checks the record framing and writes the dump, the patch is not applied here
+    bool dump(const char* a_sPath, const int32_t* a_pOps, int a_nCount, const uint32_t* a_pHandles, int a_nHandleCount,
+              const char* a_pStrings, int a_nStringLength) {
+        std::set<int> seen;
+        for (int i = 0; i < a_nCount; i += RECORD_SIZE[a_pOps[i]]) {
+            if (a_pOps[i] <= 0 || a_pOps[i] >= OP_COUNT) {
+                std::printf("volt_patch_check: unknown opcode %d at %d\n", a_pOps[i], i);
+                return false;
+            }
+            seen.insert(a_pOps[i]);
+        }
+        for (int nOp : REQUIRED_OPS) {
+            if (seen.count(nOp) == 0) {
+                std::printf("volt_patch_check: the frame did not record opcode %d\n", nOp);
+                return false;
+            }
+        }
+
+        collect(*m_pHost);
+        std::vector<std::string> handles;
+        for (int i = 0; i < a_nHandleCount; ++i) {
+            handles.push_back(describe(volt_stub::toValue(reinterpret_cast<emscripten::EM_VAL>(static_cast<uintptr_t>(a_pHandles[i])))));
+        }
+
+        std::ofstream file(a_sPath);
+        file << "{\n  \"host\": " << m_ids.at(m_pHost) << ",\n";
+        file << "  \"initial\": " << json(childrenState(*m_pHost)) << ",\n";
+        file << "  \"expected\": " << json(m_sExpected) << ",\n";
+        file << "  \"nodes\": [\n";
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            file << "    " << node(*m_nodes[i]) << (i + 1 < m_nodes.size() ? ",\n" : "\n");
+        }
+        file << "  ],\n  \"ops\": [";
+        for (int i = 0; i < a_nCount; ++i) {
+            file << (i > 0 ? "," : "") << a_pOps[i];
+        }
+        file << "],\n  \"handleIds\": [";
+        for (int i = 0; i < a_nHandleCount; ++i) {
+            file << (i > 0 ? "," : "") << a_pHandles[i];
+        }
+        file << "],\n  \"handles\": {";
+        for (int i = 0; i < a_nHandleCount; ++i) {
+            file << (i > 0 ? ", " : "") << "\"" << a_pHandles[i] << "\": " << handles[i];
+        }
+        file << "},\n  \"names\": [";
+        for (size_t i = 0; i < volt_stub::g_patchNames.size(); ++i) {
+            file << (i > 0 ? "," : "") << (volt_stub::g_patchNames[i].empty() ? "null" : json(volt_stub::g_patchNames[i]));
+        }
+        file << "],\n  \"strings\": [";
+        for (int i = 0; i < a_nStringLength; ++i) {
+            file << (i > 0 ? "," : "") << static_cast<int>(static_cast<unsigned char>(a_pStrings[i]));
+        }
+        file << "]\n}\n";
+        std::printf("volt_patch_check: %d ints, %d handles, %d string bytes, %zu opcodes\n",
+                    a_nCount, a_nHandleCount, a_nStringLength, seen.size());
+        return static_cast<bool>(file);
+    }
+
+private:
+    void collect(const Object& a_node) {
+        if (m_ids.count(&a_node) > 0) {
+            return;
+        }
+        m_ids[&a_node] = static_cast<int>(m_nodes.size());
+        m_nodes.push_back(&a_node);
+        for (const auto& pChild : a_node.children) {
+            collect(*pChild);
+        }
+    }
+
+    // A node created during the frame is not in the host yet
+    int idOf(const Object& a_node) {
+        collect(a_node);
+        return m_ids.at(&a_node);
+    }
+
+    const Object* ownerOf(const Object& a_part) {
+        for (const Object* pNode : m_nodes) {
+            if (pNode->pStyle.get() == &a_part || pNode->pClassList.get() == &a_part) {
+                return pNode;
+            }
+        }
+        return nullptr;
+    }
+
+    std::string describe(const volt_stub::Value& a_value) {
+        if (a_value.nType != volt_stub::Value::OBJECT) {
+            return "{\"value\": " + json(a_value) + "}";
+        }
+        const Object& object = *a_value.pObject;
+        switch (object.nKind) {
+            case Object::ELEMENT:
+            case Object::TEXT:
+                return "{\"node\": " + std::to_string(idOf(object)) + "}";
+            case Object::STYLE:
+            case Object::CLASS_LIST: {
+                const Object* pOwner = ownerOf(object);
+                return std::string("{\"") + (object.nKind == Object::STYLE ? "style" : "classList") + "\": " +
+                       (pOwner != nullptr ? std::to_string(m_ids.at(pOwner)) : "null") + "}";
+            }
+            case Object::FUNCTION:
+                return "{\"function\": " + json(object.sName) + "}";
+            default:
+                return "{\"value\": null}";
+        }
+    }
+
+    std::string node(const Object& a_node) {
+        if (a_node.nKind == Object::TEXT) {
+            return "{\"text\": " + json(a_node.sNodeValue) + "}";
+        }
+        std::string sOut = "{\"tag\": " + json(a_node.sName) + ", \"attributes\": [";
+        for (size_t i = 0; i < a_node.attributes.size(); ++i) {
+            sOut += (i > 0 ? ", [" : "[") + json(a_node.attributes[i].first) + ", " + json(a_node.attributes[i].second) + "]";
+        }
+        sOut += "], \"classes\": [";
+        if (a_node.pClassList) {
+            for (size_t i = 0; i < a_node.pClassList->classTokens.size(); ++i) {
+                sOut += (i > 0 ? ", " : "") + json(a_node.pClassList->classTokens[i]);
+            }
+        }
+        sOut += "], \"style\": [";
+        if (a_node.pStyle) {
+            const auto& props = a_node.pStyle->styleProperties;
+            for (size_t i = 0; i < props.size(); ++i) {
+                sOut += (i > 0 ? ", [" : "[") + json(props[i].first) + ", " + json(props[i].second) + "]";
+            }
+        }
+        sOut += "], \"properties\": [";
+        bool bFirst = true;
+        for (const auto& [sName, value] : a_node.properties) {
+            if (sName.rfind("__", 0) != 0) {
+                sOut += (bFirst ? "[" : ", [") + json(sName) + ", " + json(value) + "]";
+                bFirst = false;
+            }
+        }
+        sOut += "], \"listeners\": [";
+        for (size_t i = 0; i < a_node.listeners.size(); ++i) {
+            sOut += (i > 0 ? ", [" : "[") + json(a_node.listeners[i].first) + ", " + json(a_node.listeners[i].second->sName) + "]";
+        }
+        sOut += "], \"children\": [";
+        for (size_t i = 0; i < a_node.children.size(); ++i) {
+            sOut += (i > 0 ? ", " : "") + std::to_string(idOf(*a_node.children[i]));
+        }
+        return sOut + "]}";
+    }
+
+    const Object*                   m_pHost;
+    std::string                     m_sExpected;
+    std::map<const Object*, int>    m_ids;
+    std::vector<const Object*>      m_nodes;
+};
+
+const char* g_sDumpPath = nullptr;
+Dumper* g_pDumper = nullptr;
+bool g_bDumped = false;
+
+void dumpPatch(const int32_t* a_pOps, int a_nCount, const uint32_t* a_pHandles, int a_nHandleCount, const char* a_pStrings, int a_nStringLength) {
+    g_bDumped = g_pDumper->dump(g_sDumpPath, a_pOps, a_nCount, a_pHandles, a_nHandleCount, a_pStrings, a_nStringLength);
+}
+
+} // namespace
+
+int main(int a_nArgc, char** a_argv) {
+    if (a_nArgc < 2) {
+        std::printf("Usage: volt_patch_check <dump.json>\n");
+        return 2;
+    }
+    g_sDumpPath = a_argv[1];
+
+    // Twin first: written right away, its state is what the patch must produce
+    Scene twin = setup("twin");
+    writeFrame(twin);
+    std::string sExpected = childrenState(objectOf(twin.hHost));
+
+    Scene patched = setup("patched");
+    Dumper dumper(&objectOf(patched.hHost), sExpected);
+    g_pDumper = &dumper;
+    volt_stub::g_pApplyPatch = &dumpPatch;
+
+    dom::beginPatch();
+    writeFrame(patched);
+    if (childrenState(objectOf(patched.hHost)) == sExpected) {
+        std::printf("volt_patch_check: writes reached the DOM before the commit\n");
+        return 1;
+    }
+    dom::commitPatch();
+
+    if (!g_bDumped || volt_stub::g_nLoggedErrors > 0) {
+        std::printf("volt_patch_check: no patch dumped\n");
+        return 1;
+    }
+    return 0;
+}
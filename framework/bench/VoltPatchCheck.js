@@ -0,0 +1,369 @@
+// VoltPatchCheck.js
+// Patch buffer check, JS half: applies the patch dumped by volt_patch_check with
+// the EM_JS bridges of VoltPatch.hpp and volt._applyPatch from volt.js, against a
+// stand-in DOM, and compares the result with the state the native twin reached.
+//
+//  - in process: the bridge reads the patch off a simulated MEMORY64 heap (BigInt
+//    pointers above 4 GiB, so a ">> 2" on a pointer or an 8-byte handle shows up)
+//  - through a worker: the bridge runs in a worker_threads worker with
+//    Module.voltPostPatch set, the main thread applies the transferred copy
+//
+// Usage: node VoltPatchCheck.js <dump.json>
+
+"use strict";
+
+const fs = require("fs");
+const path = require("path");
+const vm = require("vm");
+const { Worker, isMainThread, parentPort, workerData } = require("worker_threads");
+
+const INCLUDE_DIR = path.join(__dirname, "..", "include");
+const VOLT_JS = path.join(__dirname, "..", "src", "volt.js");
+
+// ==================================================
+//   EM_JS bridges
+// ==================================================
+
+// EM_JS(ret, name, (params), { body }) blocks of a header, as functions taking the
+// Emscripten runtime they use first, then their own parameters
+function loadBridges(header) {
+  const source = fs.readFileSync(path.join(INCLUDE_DIR, header), "utf8").replace(/\r\n/g, "\n");
+  const bridges = {};
+  const pattern = /EM_JS\(\s*[\w:]+\s*,\s*(\w+)\s*,\s*\(([^)]*)\)\s*,\s*\{([\s\S]*?)\n\}\);/g;
+  let match;
+  while ((match = pattern.exec(source)) !== null) {
+    const params = match[2].split(",").map((p) => p.trim().split(/[\s*]+/).pop()).filter(Boolean);
+    bridges[match[1]] = new Function(
+      "Module", "HEAP32", "HEAPU32", "HEAPU8", "UTF8ToString", "Emval", "window",
+      ...params, match[3]
+    );
+  }
+  return bridges;
+}
+
+// ==================================================
+//   Simulated MEMORY64 heap
+// ==================================================
+
+// Above 4 GiB with bit 31 set: Number(ptr) >> 2 gives a negative index there
+const HEAP_BASE = 2 ** 32 + 2 ** 31;
+
+function makeHeap(bytes) {
+  const buffer = new ArrayBuffer(bytes);
+  let top = 0;
+
+  // Typed array indexed by absolute address / element size
+  function view(Type) {
+    const array = new Type(buffer);
+    const shift = HEAP_BASE / Type.BYTES_PER_ELEMENT;
+    return new Proxy(array, {
+      get(target, key) {
+        if (typeof key === "string" && /^\d+$/.test(key)) return target[Number(key) - shift];
+        if (typeof key === "string" && /^-/.test(key)) throw new Error("negative heap index " + key);
+        if (key === "subarray") return (begin, end) => {
+          if (!Number.isInteger(begin) || begin < shift) throw new Error("bad heap view at " + begin);
+          return target.subarray(begin - shift, end - shift);
+        };
+        const value = target[key];
+        return typeof value === "function" ? value.bind(target) : value;
+      },
+    });
+  }
+
+  const heap = {
+    HEAP32: view(Int32Array),
+    HEAPU32: view(Uint32Array),
+    HEAPU8: view(Uint8Array),
+    // Writes a typed array, returns its BigInt address
+    store(array) {
+      const offset = top;
+      new Uint8Array(buffer, offset, array.byteLength).set(new Uint8Array(array.buffer, array.byteOffset, array.byteLength));
+      top += (array.byteLength + 7) & ~7;
+      return BigInt(HEAP_BASE + offset);
+    },
+    UTF8ToString(ptr, maxBytes) {
+      const bytes = new Uint8Array(buffer);
+      const start = Number(ptr) - HEAP_BASE;
+      let end = start;
+      while (bytes[end] !== 0 && (maxBytes === undefined || end - start < maxBytes)) end++;
+      return new TextDecoder().decode(bytes.subarray(start, end));
+    },
+  };
+  return heap;
+}
+
+// Runs the bridges of VoltPatch.hpp for the dumped patch: names first, then the commit
+function runBridges(dump, Module, window, Emval) {
+  const bridges = loadBridges("VoltPatch.hpp");
+  const heap = makeHeap(1 << 20);
+  if ((HEAP_BASE >> 2) === HEAP_BASE / 4) throw new Error("heap base does not exercise 64-bit pointers");
+
+  const run = (name, ...args) =>
+    bridges[name](Module, heap.HEAP32, heap.HEAPU32, heap.HEAPU8, heap.UTF8ToString, Emval, window, ...args);
+
+  dump.names.forEach((name, id) => {
+    if (name !== null) run("volt_js_register_patch_name", id, heap.store(new TextEncoder().encode(name + "\0")));
+  });
+
+  const ops = Int32Array.from(dump.ops);
+  const handles = Uint32Array.from(dump.handleIds);
+  const strings = Uint8Array.from(dump.strings);
+  run(
+    "volt_js_apply_patch",
+    heap.store(ops), ops.length,
+    heap.store(handles), handles.length,
+    heap.store(strings), strings.length
+  );
+}
+
+// ==================================================
+//   Stand-in DOM
+// ==================================================
+
+function hidden(object, key, value) {
+  Object.defineProperty(object, key, { value, writable: true, enumerable: false });
+}
+
+function splitTokens(text) {
+  return String(text).split(" ").filter((t) => t.length > 0);
+}
+
+class Style {
+  constructor() { hidden(this, "props", []); }
+  setProperty(name, value) {
+    const prop = this.props.find((p) => p[0] === name);
+    if (prop) prop[1] = value; else this.props.push([name, value]);
+  }
+  removeProperty(name) { this.props = this.props.filter((p) => p[0] !== name); }
+  get cssText() { return this.props.map(([n, v]) => `${n}: ${v};`).join(" "); }
+  set cssText(text) {
+    this.props = [];
+    for (const declaration of String(text).split(";")) {
+      const colon = declaration.indexOf(":");
+      if (colon < 0) continue;
+      const name = declaration.slice(0, colon).replace(/^ +| +$/g, "");
+      const value = declaration.slice(colon + 1).replace(/^ +| +$/g, "");
+      if (name && value) this.setProperty(name, value);
+    }
+  }
+}
+
+class ClassList {
+  constructor() { hidden(this, "tokens", []); }
+  add(token) { if (!this.tokens.includes(token)) this.tokens.push(token); }
+  remove(token) { this.tokens = this.tokens.filter((t) => t !== token); }
+}
+
+class Text {
+  constructor(value) { hidden(this, "value", value); hidden(this, "parentNode", null); }
+  get nodeValue() { return this.value; }
+  set nodeValue(value) { this.value = String(value); }
+}
+
+class Element {
+  constructor(tag) {
+    hidden(this, "tag", tag);
+    hidden(this, "attrs", []);
+    hidden(this, "style", new Style());
+    hidden(this, "classList", new ClassList());
+    hidden(this, "childNodes", []);
+    hidden(this, "parentNode", null);
+    hidden(this, "listeners", []);
+  }
+  setAttribute(name, value) {
+    value = String(value);
+    if (name === "class") { this.classList.tokens = splitTokens(value); return; }
+    if (name === "style") { this.style.cssText = value; return; }
+    const attr = this.attrs.find((a) => a[0] === name);
+    if (attr) attr[1] = value; else this.attrs.push([name, value]);
+  }
+  removeAttribute(name) {
+    if (name === "class") { this.classList.tokens = []; return; }
+    if (name === "style") { this.style.props = []; return; }
+    this.attrs = this.attrs.filter((a) => a[0] !== name);
+  }
+  toggleAttribute(name, force) {
+    if (force) this.setAttribute(name, ""); else this.removeAttribute(name);
+    return force;
+  }
+  insertBefore(child, reference) {
+    if (child.parentNode) child.parentNode.removeChild(child);
+    const at = reference ? this.childNodes.indexOf(reference) : -1;
+    if (at < 0) this.childNodes.push(child); else this.childNodes.splice(at, 0, child);
+    child.parentNode = this;
+    return child;
+  }
+  appendChild(child) { return this.insertBefore(child, null); }
+  removeChild(child) {
+    this.childNodes.splice(this.childNodes.indexOf(child), 1);
+    child.parentNode = null;
+    return child;
+  }
+  addEventListener(type, fn) {
+    if (!this.listeners.some((l) => l[0] === type && l[1] === fn)) this.listeners.push([type, fn]);
+  }
+  removeEventListener(type, fn) {
+    this.listeners = this.listeners.filter((l) => !(l[0] === type && l[1] === fn));
+  }
+}
+
+// The dumped DOM, and the resolver from handle id to node, style, classList or value
+function buildDom(dump) {
+  const functions = new Map();
+  const fn = (name) => {
+    if (!functions.has(name)) {
+      const f = function () {};
+      Object.defineProperty(f, "name", { value: name });
+      functions.set(name, f);
+    }
+    return functions.get(name);
+  };
+
+  const nodes = dump.nodes.map((n) => (n.tag === undefined ? new Text(n.text) : new Element(n.tag)));
+  dump.nodes.forEach((n, i) => {
+    if (n.tag === undefined) return;
+    const el = nodes[i];
+    el.attrs = n.attributes.map((a) => a.slice());
+    el.classList.tokens = n.classes.slice();
+    el.style.props = n.style.map((p) => p.slice());
+    n.properties.forEach(([name, value]) => { el[name] = value; });
+    el.listeners = n.listeners.map(([type, name]) => [type, fn(name)]);
+    n.children.forEach((c) => { el.childNodes.push(nodes[c]); nodes[c].parentNode = el; });
+  });
+
+  const resolve = (id) => {
+    const h = dump.handles[id];
+    if (h === undefined) throw new Error("unknown handle id " + id);
+    if ("node" in h) return nodes[h.node];
+    if ("style" in h) return nodes[h.style].style;
+    if ("classList" in h) return nodes[h.classList].classList;
+    if ("function" in h) return fn(h.function);
+    return h.value;
+  };
+  return { host: nodes[dump.host], resolve };
+}
+
+// ==================================================
+//   State, as appendState() in VoltPatchCheck.cpp
+// ==================================================
+
+function escape(text, attribute) {
+  return String(text).replace(/[&<>"]/g, (c) =>
+    c === "&" ? "&amp;" : c === "<" ? "&lt;" : c === ">" ? "&gt;" : attribute ? "&quot;" : c);
+}
+
+function compare(a, b) {
+  return a < b ? -1 : a > b ? 1 : 0;
+}
+
+function state(node) {
+  if (node instanceof Text) return escape(node.nodeValue, false);
+
+  const attrs = node.attrs.map((a) => a.slice());
+  if (node.classList.tokens.length > 0) attrs.push(["class", node.classList.tokens.slice().sort(compare).join(" ")]);
+  if (node.style.props.length > 0) {
+    const props = node.style.props.slice().sort((x, y) => compare(x[0], y[0]) || compare(x[1], y[1]));
+    attrs.push(["style", props.map(([n, v]) => `${n}: ${v};`).join(" ")]);
+  }
+  attrs.sort((x, y) => compare(x[0], y[0]) || compare(x[1], y[1]));
+
+  let out = "<" + node.tag;
+  for (const [name, value] of attrs) out += ` ${name}="${escape(value, true)}"`;
+  for (const name of Object.keys(node).sort(compare)) out += ` .${name}="${escape(node[name], true)}"`;
+  for (const listener of node.listeners.map(([type, f]) => `${type}=${f.name}`).sort(compare)) out += " @" + listener;
+  out += ">";
+  for (const child of node.childNodes) out += state(child);
+  return out + "</" + node.tag + ">";
+}
+
+function childrenState(node) {
+  return node.childNodes.map(state).join("");
+}
+
+// ==================================================
+//   Checks
+// ==================================================
+
+function loadVolt() {
+  const context = vm.createContext({ console, TextDecoder, SharedArrayBuffer, performance });
+  context.window = context;
+  vm.runInContext(fs.readFileSync(VOLT_JS, "utf8"), context, { filename: VOLT_JS });
+  return context.volt;
+}
+
+function expectState(label, dump, actual) {
+  if (actual !== dump.expected) {
+    console.log(`${label}: DOM does not match the twin\n  expected: ${dump.expected}\n  actual:   ${actual}`);
+    return false;
+  }
+  console.log(`${label}: ok`);
+  return true;
+}
+
+function checkInProcess(dump, volt) {
+  const dom = buildDom(dump);
+  if (childrenState(dom.host) !== dump.initial) {
+    console.log(`stand-in DOM differs from the dump\n  dump:     ${dump.initial}\n  stand-in: ${childrenState(dom.host)}`);
+    return false;
+  }
+  runBridges(dump, {}, { volt }, { toValue: dom.resolve });
+  return expectState("in process, MEMORY64 heap", dump, childrenState(dom.host));
+}
+
+function checkWorker(dumpPath, dump, volt) {
+  return new Promise((resolve, reject) => {
+    const worker = new Worker(__filename, { workerData: { dumpPath } });
+    worker.once("error", reject);
+    worker.once("message", (patch) => {
+      worker.terminate();
+      if (!(patch.ops instanceof Int32Array) || !(patch.handles instanceof Uint32Array) || !(patch.strings instanceof Uint8Array)) {
+        console.log("worker: the posted patch is not made of typed arrays");
+        resolve(false);
+        return;
+      }
+      if (patch.handles.join() !== dump.handleIds.join()) {
+        console.log("worker: handle ids changed on the way");
+        resolve(false);
+        return;
+      }
+      const dom = buildDom(dump);
+      volt._applyPatch(patch, dom.resolve);
+      resolve(expectState("worker, posted patch", dump, childrenState(dom.host)));
+    });
+  });
+}
+
+// Worker side: the bridge posts the patch instead of applying it, no window
+function runWorker() {
+  const dump = JSON.parse(fs.readFileSync(workerData.dumpPath, "utf8"));
+  const Module = {
+    voltPostPatch(patch) {
+      parentPort.postMessage(patch, [patch.ops.buffer, patch.handles.buffer, patch.strings.buffer]);
+    },
+  };
+  const Emval = { toValue: () => { throw new Error("the worker resolved a handle"); } };
+  runBridges(dump, Module, undefined, Emval);
+}
+
+async function main() {
+  const dumpPath = process.argv[2];
+  if (!dumpPath) {
+    console.log("Usage: node VoltPatchCheck.js <dump.json>");
+    process.exit(2);
+  }
+  const dump = JSON.parse(fs.readFileSync(dumpPath, "utf8"));
+  const volt = loadVolt();
+
+  let ok = checkInProcess(dump, volt);
+  ok = (await checkWorker(dumpPath, dump, volt)) && ok;
+  process.exit(ok ? 0 : 1);
+}
+
+if (isMainThread) {
+  main().catch((err) => {
+    console.error(err);
+    process.exit(1);
+  });
+} else {
+  runWorker();
+}
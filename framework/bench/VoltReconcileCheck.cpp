@@ -0,0 +1,500 @@
+// ============================================================================
+// Volt reconciler check
+// ============================================================================
+// Random tree pairs (conditional sections, keyed lists with reorders, inserts
+// and removals, fragments, nested map()) rendered one after the other by a
+// real engine, against the recording DOM in domstub/. Each case renders
+// A, B, then A again, with focus on a random element in some cases. After
+// every frame:
+// - the DOM must serialize to the markup the reference model computes
+// - every element whose identity (the chain of track indexes and keys from
+//   the root) is in both trees must keep its DOM element
+// - the DOM writes of the frame must match the golden counts
+//
+// Usage: volt_reconcile_check <golden file> [--update]
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <Volt.hpp>
+#include <DomStub.hpp>
+
+using namespace volt;
+
+namespace {
+
+// ============================================================================
+// Reference model
+// ============================================================================
+
+// One node of a generated tree
+struct Spec {
+    enum EKind { ELEMENT, TEXT, FRAGMENT, LIST };
+
+    EKind                   nKind = ELEMENT;
+    tag::ETag               nTag = tag::ETag::div;
+    int                     nTrack = 0;     // Position among the siblings, list items use their key
+    std::string             sKey;
+    bool                    bShown = true;  // Hidden sections render an empty fragment, as the _if helpers do
+    std::string             sTitle;
+    std::vector<std::string> classes;       // Sorted, no duplicates
+    std::string             sText;          // TEXT
+    std::vector<Spec>       children;
+};
+
+// Track of the empty fragment that stands in for a hidden section
+constexpr int HIDDEN_TRACK = 500;
+
+void appendExpected(std::string& a_sOut, const Spec& a_spec) {
+    if (a_spec.nKind == Spec::TEXT) {
+        volt_stub::appendEscaped(a_sOut, a_spec.sText, false);
+        return;
+    }
+    if (a_spec.nKind == Spec::ELEMENT && !a_spec.bShown) {
+        return;
+    }
+    if (a_spec.nKind == Spec::ELEMENT) {
+        a_sOut += '<';
+        a_sOut += tag::tagToString(a_spec.nTag);
+        if (!a_spec.classes.empty()) {
+            a_sOut += " class=\"";
+            for (size_t i = 0; i < a_spec.classes.size(); ++i) {
+                a_sOut += (i > 0 ? " " : "") + a_spec.classes[i];
+            }
+            a_sOut += '"';
+        }
+        if (!a_spec.sTitle.empty()) {
+            a_sOut += " title=\"";
+            volt_stub::appendEscaped(a_sOut, a_spec.sTitle, true);
+            a_sOut += '"';
+        }
+        a_sOut += '>';
+    }
+    for (const Spec& child : a_spec.children) {
+        appendExpected(a_sOut, child);
+    }
+    if (a_spec.nKind == Spec::ELEMENT) {
+        a_sOut += "</";
+        a_sOut += tag::tagToString(a_spec.nTag);
+        a_sOut += '>';
+    }
+}
+
+// Identities of the rendered elements, in document order
+void collectIdentities(const Spec& a_spec, const std::string& a_sPath, std::vector<std::string>& a_identities) {
+    switch (a_spec.nKind) {
+        case Spec::TEXT:
+            return;
+        case Spec::ELEMENT: {
+            if (!a_spec.bShown) {
+                return;
+            }
+            std::string sIdentity = a_sPath + (a_spec.sKey.empty() ? "T" + std::to_string(a_spec.nTrack) : "S" + a_spec.sKey) + "/";
+            a_identities.push_back(sIdentity);
+            for (const Spec& child : a_spec.children) {
+                collectIdentities(child, sIdentity, a_identities);
+            }
+            return;
+        }
+        default: {
+            std::string sPath = a_sPath + "T" + std::to_string(a_spec.nTrack) + "/";
+            for (const Spec& child : a_spec.children) {
+                collectIdentities(child, sPath, a_identities);
+            }
+            return;
+        }
+    }
+}
+
+VNodeHandle build(const Spec& a_spec) {
+    switch (a_spec.nKind) {
+        case Spec::TEXT:
+            return VNodeHandle(a_spec.sText);
+        case Spec::FRAGMENT: {
+            std::vector<VNodeHandle> children;
+            for (const Spec& child : a_spec.children) {
+                children.push_back(build(child));
+            }
+            return tag::_fragment(std::move(children)).track(a_spec.nTrack);
+        }
+        case Spec::LIST:
+            return map(a_spec.children, [](const Spec& a_item, size_t) { return build(a_item); }).track(a_spec.nTrack);
+        default:
+            break;
+    }
+    if (!a_spec.bShown) {
+        return tag::_fragment().track(a_spec.nTrack + HIDDEN_TRACK);
+    }
+    std::vector<VNodeHandle::Prop> props;
+    if (!a_spec.sKey.empty()) {
+        props.push_back(attr::key(a_spec.sKey));
+    }
+    if (!a_spec.sTitle.empty()) {
+        props.push_back(attr::title(a_spec.sTitle));
+    }
+    for (const std::string& sClass : a_spec.classes) {
+        props.push_back(attr::classtoken(sClass));
+    }
+    std::vector<VNodeHandle> children;
+    for (const Spec& child : a_spec.children) {
+        children.push_back(build(child));
+    }
+    VNodeHandle element(a_spec.nTag, std::move(props), std::move(children));
+    return a_spec.sKey.empty() ? element.track(a_spec.nTrack) : element;
+}
+
+// ============================================================================
+// Generator
+// ============================================================================
+
+class Generator {
+public:
+    explicit Generator(uint32_t a_nSeed) : m_random(a_nSeed) {}
+
+    Spec tree() {
+        Spec root = element(0, 0);
+        root.bShown = true;
+        return root;
+    }
+
+    Spec mutate(const Spec& a_spec) {
+        Spec spec = a_spec;
+        switch (spec.nKind) {
+            case Spec::TEXT:
+                if (chance(30)) {
+                    spec.sText = text();
+                }
+                break;
+            case Spec::ELEMENT:
+                if (chance(20)) {
+                    spec.sTitle = chance(70) ? "t" + std::to_string(pick(5)) : "";
+                }
+                if (chance(15)) {
+                    toggleClass(spec);
+                }
+                mutateChildren(spec);
+                break;
+            case Spec::FRAGMENT:
+                mutateChildren(spec);
+                break;
+            case Spec::LIST:
+                mutateList(spec);
+                break;
+        }
+        return spec;
+    }
+
+private:
+    bool chance(int a_nPercent) { return static_cast<int>(m_random() % 100) < a_nPercent; }
+    int pick(int a_nCount) { return static_cast<int>(m_random() % a_nCount); }
+
+    std::string text() { return "text " + std::to_string(pick(4)) + (chance(10) ? " & <more>" : ""); }
+
+    void toggleClass(Spec& a_spec) {
+        std::string sClass = "c" + std::to_string(pick(3));
+        auto it = std::lower_bound(a_spec.classes.begin(), a_spec.classes.end(), sClass);
+        if (it != a_spec.classes.end() && *it == sClass) {
+            a_spec.classes.erase(it);
+        } else {
+            a_spec.classes.insert(it, sClass);
+        }
+    }
+
+    // Positioned children: unique, growing tracks with gaps, as call sites produce
+    std::vector<Spec> children(int a_nDepth) {
+        std::vector<Spec> result;
+        int nCount = a_nDepth == 0 ? 2 + pick(4) : pick(a_nDepth >= 3 ? 2 : 4);
+        int nTrack = pick(3);
+        for (int i = 0; i < nCount; ++i) {
+            int nRoll = pick(100);
+            if (nRoll < 20) {
+                Spec textNode;
+                textNode.nKind = Spec::TEXT;
+                textNode.sText = text();
+                result.push_back(textNode);
+                continue;
+            }
+            nTrack += 1 + pick(2);
+            if (nRoll < 40 && a_nDepth < 3) {
+                result.push_back(list(a_nDepth + 1, nTrack));
+            } else if (nRoll < 55 && a_nDepth < 3) {
+                Spec fragment;
+                fragment.nKind = Spec::FRAGMENT;
+                fragment.nTrack = nTrack;
+                fragment.children = children(a_nDepth + 1);
+                result.push_back(fragment);
+            } else {
+                result.push_back(element(a_nDepth + 1, nTrack));
+            }
+        }
+        return result;
+    }
+
+    Spec element(int a_nDepth, int a_nTrack) {
+        const tag::ETag tags[] = {tag::ETag::div, tag::ETag::section, tag::ETag::p, tag::ETag::span};
+        Spec spec;
+        spec.nTag = tags[pick(4)];
+        spec.nTrack = a_nTrack;
+        spec.bShown = !chance(15);
+        if (chance(30)) {
+            spec.sTitle = "t" + std::to_string(pick(5));
+        }
+        if (chance(30)) {
+            toggleClass(spec);
+        }
+        spec.children = children(a_nDepth);
+        return spec;
+    }
+
+    Spec list(int a_nDepth, int a_nTrack) {
+        Spec spec;
+        spec.nKind = Spec::LIST;
+        spec.nTrack = a_nTrack;
+        int nCount = pick(7);
+        for (int i = 0; i < nCount; ++i) {
+            spec.children.push_back(item(a_nDepth));
+        }
+        return spec;
+    }
+
+    // <li key> with a text and sometimes a nested map()
+    Spec item(int a_nDepth) {
+        Spec spec;
+        spec.nTag = tag::ETag::li;
+        spec.sKey = "k" + std::to_string(m_nNextKey++);
+        Spec label;
+        label.nKind = Spec::TEXT;
+        label.sText = text();
+        spec.children.push_back(label);
+        if (a_nDepth < 3 && chance(25)) {
+            spec.children.push_back(list(a_nDepth + 1, 1));
+        }
+        return spec;
+    }
+
+    void mutateChildren(Spec& a_spec) {
+        for (Spec& child : a_spec.children) {
+            child = mutate(child);
+            if (child.nKind == Spec::ELEMENT && child.sKey.empty() && chance(15)) {
+                child.bShown = !child.bShown;
+            }
+        }
+    }
+
+    void mutateList(Spec& a_spec) {
+        std::vector<Spec>& items = a_spec.children;
+        if (chance(20) && !items.empty()) {
+            int nRemove = 1 + pick(static_cast<int>(items.size()));
+            for (int i = 0; i < nRemove && !items.empty(); ++i) {
+                items.erase(items.begin() + pick(static_cast<int>(items.size())));
+            }
+        }
+        if (chance(25)) {
+            int nInsert = 1 + pick(3);
+            for (int i = 0; i < nInsert; ++i) {
+                items.insert(items.begin() + pick(static_cast<int>(items.size()) + 1), item(2));
+            }
+        }
+        if (chance(35)) {
+            std::shuffle(items.begin(), items.end(), m_random);
+        } else if (chance(15)) {
+            std::reverse(items.begin(), items.end());
+        } else if (chance(25) && items.size() > 1) {
+            Spec moved = items[pick(static_cast<int>(items.size()))];
+            items.erase(std::find_if(items.begin(), items.end(), [&](const Spec& a_item) { return a_item.sKey == moved.sKey; }));
+            items.insert(items.begin() + pick(static_cast<int>(items.size()) + 1), moved);
+        }
+        for (Spec& listItem : items) {
+            listItem = mutate(listItem);
+        }
+    }
+
+    std::mt19937 m_random;
+    int m_nNextKey = 0;
+};
+
+// ============================================================================
+// Engine
+// ============================================================================
+
+const Spec* g_pSpec = nullptr;
+
+class CheckApp : public App {
+public:
+    CheckApp(IRuntime& a_runtime) : App(a_runtime) {}
+    VNodeHandle render() override { return build(*g_pSpec); }
+};
+
+emscripten::val g_hHost;
+
+std::string hostMarkup() {
+    std::string sMarkup;
+    for (const auto& pChild : g_hHost.value().pObject->children) {
+        volt_stub::appendMarkup(sMarkup, *pChild);
+    }
+    return sMarkup;
+}
+
+void collectElements(const volt_stub::Object& a_node, std::vector<const volt_stub::Object*>& a_elements) {
+    for (const auto& pChild : a_node.children) {
+        if (pChild->nKind == volt_stub::Object::ELEMENT) {
+            a_elements.push_back(pChild.get());
+            collectElements(*pChild, a_elements);
+        }
+    }
+}
+
+// Element serial per identity, once the markup matched
+std::map<std::string, int> elementsByIdentity(const Spec& a_spec) {
+    std::vector<std::string> identities;
+    collectIdentities(a_spec, "", identities);
+    std::vector<const volt_stub::Object*> elements;
+    collectElements(*g_hHost.value().pObject, elements);
+    std::map<std::string, int> result;
+    for (size_t i = 0; i < identities.size() && i < elements.size(); ++i) {
+        result[identities[i]] = elements[i]->nSerial;
+    }
+    return result;
+}
+
+struct Frame {
+    const Spec*                 pSpec;
+    std::map<std::string, int>  elements;
+};
+
+// Renders a_spec, checks markup and reuse against the previous frame, returns false on a mismatch
+bool renderFrame(VoltEngine& a_engine, const std::string& a_sName, const Spec& a_spec, Frame* a_pPrevious, Frame& a_frame, std::vector<std::string>& a_counts) {
+    volt_stub::g_domCounts = volt_stub::DomCounts();
+    int nErrors = volt_stub::g_nLoggedErrors;
+    g_pSpec = &a_spec;
+    a_engine.invalidate();
+    volt_stub::runAnimationFrame();
+    a_counts.push_back(a_sName + ": " + volt_stub::g_domCounts.toString());
+
+    if (volt_stub::g_nLoggedErrors != nErrors) {
+        std::printf("%s: the framework logged an error\n", a_sName.c_str());
+        return false;
+    }
+    std::string sExpected;
+    appendExpected(sExpected, a_spec);
+    std::string sActual = hostMarkup();
+    if (sActual != sExpected) {
+        std::printf("%s: DOM does not match the reference\n  expected: %s\n  actual:   %s\n", a_sName.c_str(), sExpected.c_str(), sActual.c_str());
+        return false;
+    }
+
+    a_frame.pSpec = &a_spec;
+    a_frame.elements = elementsByIdentity(a_spec);
+    if (a_pPrevious != nullptr) {
+        for (const auto& [sIdentity, nSerial] : a_frame.elements) {
+            auto it = a_pPrevious->elements.find(sIdentity);
+            if (it != a_pPrevious->elements.end() && it->second != nSerial) {
+                std::printf("%s: element %s was recreated instead of reused\n", a_sName.c_str(), sIdentity.c_str());
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Focus on a random rendered element, as volt.js reports it
+void focusRandomElement(VoltEngine& a_engine, std::mt19937& a_random) {
+    std::vector<const volt_stub::Object*> elements;
+    collectElements(*g_hHost.value().pObject, elements);
+    if (elements.empty()) {
+        return;
+    }
+    const volt_stub::Object* pElement = elements[a_random() % elements.size()];
+    auto it = pElement->properties.find("__volt_node");
+    if (it != pElement->properties.end()) {
+        a_engine.setFocussedNode(static_cast<VNodeId>(it->second.fNumber));
+    }
+}
+
+std::vector<std::string> readLines(const char* a_sPath) {
+    std::vector<std::string> lines;
+    std::ifstream file(a_sPath);
+    std::string sLine;
+    while (std::getline(file, sLine)) {
+        if (!sLine.empty() && sLine.back() == '\r') {
+            sLine.pop_back();
+        }
+        if (!sLine.empty() && sLine[0] != '#') {
+            lines.push_back(sLine);
+        }
+    }
+    return lines;
+}
+
+} // namespace
+
+int main(int a_nArgc, char** a_argv) {
+    if (a_nArgc < 2) {
+        std::printf("Usage: volt_reconcile_check <golden file> [--update]\n");
+        return 2;
+    }
+    const char* sGoldenPath = a_argv[1];
+    bool bUpdate = a_nArgc > 2 && std::string(a_argv[2]) == "--update";
+    const int nCases = 300;
+
+    emscripten::val hDocument = emscripten::val::global("document");
+    g_hHost = hDocument.call<emscripten::val>("createElement", std::string("div"));
+    g_hHost.call<void>("setAttribute", std::string("id"), std::string("root"));
+    hDocument["body"].call<void>("appendChild", g_hHost);
+
+    std::vector<std::string> counts;
+    int nFailures = 0;
+    for (int nCase = 0; nCase < nCases; ++nCase) {
+        Generator generator(static_cast<uint32_t>(nCase));
+        Spec a = generator.tree();
+        Spec b = generator.mutate(a);
+        std::mt19937 focusRandom(static_cast<uint32_t>(nCase));
+        bool bFocus = nCase % 4 == 3;
+
+        std::string sCase = "case " + std::to_string(nCase);
+        VoltEngine engine("root", "check");
+        engine.mountApp<CheckApp>();
+        Frame frameA, frameB, frameA2;
+        bool bOk = renderFrame(engine, sCase + " A", a, nullptr, frameA, counts);
+        if (bOk && bFocus) {
+            focusRandomElement(engine, focusRandom);
+        }
+        bOk = bOk && renderFrame(engine, sCase + " A->B", b, &frameA, frameB, counts);
+        bOk = bOk && renderFrame(engine, sCase + " B->A", a, &frameB, frameA2, counts);
+        if (!bOk) {
+            ++nFailures;
+        }
+    }
+    g_pSpec = nullptr;
+    g_hHost = emscripten::val(); // Before the handle table goes away
+
+    if (bUpdate) {
+        std::ofstream file(sGoldenPath);
+        file << "# DOM writes per frame of volt_reconcile_check, regenerate with --update after an intended change\n";
+        for (const std::string& sLine : counts) {
+            file << sLine << '\n';
+        }
+        std::printf("volt_reconcile_check: wrote %zu frames to %s\n", counts.size(), sGoldenPath);
+        return nFailures > 0 ? 1 : 0;
+    }
+
+    std::vector<std::string> golden = readLines(sGoldenPath);
+    int nCountMismatches = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        if (i >= golden.size() || golden[i] != counts[i]) {
+            if (nCountMismatches < 10) {
+                std::printf("DOM writes changed\n  golden: %s\n  now:    %s\n", i < golden.size() ? golden[i].c_str() : "(missing)", counts[i].c_str());
+            }
+            ++nCountMismatches;
+        }
+    }
+    if (golden.size() != counts.size()) {
+        std::printf("golden file has %zu frames, the check ran %zu\n", golden.size(), counts.size());
+        ++nCountMismatches;
+    }
+
+    std::printf("volt_reconcile_check: %d cases, %d failed, %d frames with changed DOM writes\n", nCases, nFailures, nCountMismatches);
+    return nFailures > 0 || nCountMismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+// ============================================================================
+// JS bridges of the recording DOM stub
+// ============================================================================
+// The EM_JS functions of framework/include, implemented against the DOM model
+// in emscripten/val.h. Include once, after Volt.hpp, in the check's only TU.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using volt_stub::Value;
+
+EM_VAL volt_js_utf8_string(const char* a_pBytes, size_t a_nLength) {
+    return volt_stub::toHandle(Value::string(std::string(a_pBytes, a_nLength)));
+}
+
+size_t js_string_length(EM_VAL a_hS) {
+    return volt_stub::toValue(a_hS).sString.size();
+}
+
+EM_VAL js_string_concat(EM_VAL a_hS1, EM_VAL a_hS2) {
+    return volt_stub::toHandle(Value::string(volt_stub::toValue(a_hS1).sString + volt_stub::toValue(a_hS2).sString));
+}
+
+EM_VAL create_js_string(const char* a_cStr) {
+    return volt_stub::toHandle(Value::string(a_cStr));
+}
+
+EM_VAL i32_to_js_string(int a_n) {
+    return volt_stub::toHandle(Value::string(std::to_string(a_n)));
+}
+
+bool js_string_equals(EM_VAL a_hS1, EM_VAL a_hS2) {
+    return volt_stub::strictlyEquals(volt_stub::toValue(a_hS1), volt_stub::toValue(a_hS2));
+}
+
+void volt_js_log(int, const char*, int, const char*) {}
+
+// The patch applier is JS only (volt.js), a check that records patches installs a hook
+namespace volt_stub {
+    inline void (*g_pApplyPatch)(const int32_t*, int, const uint32_t*, int, const char*, int) = nullptr;
+    inline std::vector<std::string> g_patchNames; // Module.__voltPatchNames
+}
+
+void volt_js_apply_patch(const int32_t* a_pOps, int a_nCount, const uint32_t* a_pHandles, int a_nHandleCount, const char* a_pStrings, int a_nStringLength) {
+    if (volt_stub::g_pApplyPatch == nullptr) {
+        std::fprintf(stderr, "volt_js_apply_patch: no patch hook installed\n");
+        ++volt_stub::g_nLoggedErrors;
+        return;
+    }
+    volt_stub::g_pApplyPatch(a_pOps, a_nCount, a_pHandles, a_nHandleCount, a_pStrings, a_nStringLength);
+}
+
+void volt_js_register_patch_name(int a_nId, const char* a_pName) {
+    if (volt_stub::g_patchNames.size() <= static_cast<size_t>(a_nId)) {
+        volt_stub::g_patchNames.resize(a_nId + 1);
+    }
+    volt_stub::g_patchNames[a_nId] = a_pName;
+}
+
+void volt_js_profile_frame(const char*, double, double, double, double, double, double,
+                           int, int, int, int, int, int, int, int, int) {}
+
+int volt_js_span_enabled(const char*) { return 0; }
+
+void volt_js_span(const char*, const char*, double, double, int) {}
+
+void volt_js_post_task() {}
+
+void volt_js_request_idle(double) {}
@@ -0,0 +1,57 @@
+#pragma once
+
+// ============================================================================
+// Recording stand-in for the Emscripten runtime
+// ============================================================================
+// Like stub/emscripten/emscripten.h, except that EM_JS only declares the
+// bridge: DomStub.hpp defines each one against the DOM model in val.h, so a
+// bridge it does not know is a link error instead of a silent no-op.
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <emscripten/val.h>
+
+using emscripten::EM_VAL;
+
+#define EM_JS(ret, name, params, ...) ret name params;
+#define EM_ASM(...) ((void)0)
+#define EM_ASM_INT(...) 0
+#define EM_ASM_DOUBLE(...) 0.0
+#define EMSCRIPTEN_KEEPALIVE
+
+typedef int EM_BOOL;
+#define EM_TRUE 1
+#define EM_FALSE 0
+
+#define EM_LOG_CONSOLE 1
+#define EM_LOG_WARN    2
+#define EM_LOG_ERROR   4
+#define EM_LOG_INFO    512
+
+namespace volt_stub {
+    inline int g_nLoggedErrors = 0; // A check fails when the framework reported an error
+}
+
+inline void emscripten_log(int a_nFlags, const char* a_sFormat, ...) {
+    if ((a_nFlags & (EM_LOG_WARN | EM_LOG_ERROR)) == 0) {
+        return;
+    }
+    if ((a_nFlags & EM_LOG_ERROR) != 0) {
+        ++volt_stub::g_nLoggedErrors;
+    }
+    va_list args;
+    va_start(args, a_sFormat);
+    std::vfprintf(stderr, a_sFormat, args);
+    std::fputc('\n', stderr);
+    va_end(args);
+}
+
+inline double emscripten_get_now() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+inline double emscripten_performance_now() {
+    return emscripten_get_now();
+}
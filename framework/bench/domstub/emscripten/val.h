@@ -0,0 +1,876 @@
+#pragma once
+
+// ============================================================================
+// Recording stand-in for emscripten::val
+// ============================================================================
+// A small JS value model with a DOM behind it, for the host checks in
+// framework/bench (see README.md). Values live in a refcounted handle table
+// like Emval's, so as_handle() identities behave as in the browser: copies
+// share a handle, every property read makes a new one.
+//
+// The DOM knows what the reconciler uses: elements, text nodes, attributes,
+// own properties, style, classList, childNodes and listeners. Every write is counted in
+// volt_stub::g_domCounts, and volt_stub::appendMarkup() serializes a subtree.
+
+#include <stdint.h>
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace emscripten {
+struct _EM_VAL;
+typedef _EM_VAL* EM_VAL;
+}
+
+namespace volt_stub {
+
+// ============================================================================
+// Values
+// ============================================================================
+
+struct Object;
+
+struct Value {
+    enum EType { UNDEFINED, NULL_VALUE, BOOLEAN, NUMBER, STRING, OBJECT };
+
+    EType                   nType = UNDEFINED;
+    double                  fNumber = 0; // BOOLEAN and NUMBER
+    std::string             sString;
+    std::shared_ptr<Object> pObject;
+
+    static Value null() { Value v; v.nType = NULL_VALUE; return v; }
+    static Value boolean(bool a_b) { Value v; v.nType = BOOLEAN; v.fNumber = a_b ? 1 : 0; return v; }
+    static Value number(double a_f) { Value v; v.nType = NUMBER; v.fNumber = a_f; return v; }
+    static Value string(std::string a_s) { Value v; v.nType = STRING; v.sString = std::move(a_s); return v; }
+    static Value object(std::shared_ptr<Object> a_p) { Value v; v.nType = OBJECT; v.pObject = std::move(a_p); return v; }
+};
+
+// JS String(n) for the values the DOM sees: shortest round-trip form
+inline std::string numberToString(double a_f) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), a_f);
+    return std::string(buffer, result.ptr);
+}
+
+inline std::string toString(const Value& a_value) {
+    switch (a_value.nType) {
+        case Value::UNDEFINED:  return "undefined";
+        case Value::NULL_VALUE: return "null";
+        case Value::BOOLEAN:    return a_value.fNumber != 0 ? "true" : "false";
+        case Value::NUMBER:     return numberToString(a_value.fNumber);
+        case Value::STRING:     return a_value.sString;
+        default:                return "[object]";
+    }
+}
+
+inline double toNumber(const Value& a_value) {
+    switch (a_value.nType) {
+        case Value::BOOLEAN:
+        case Value::NUMBER:     return a_value.fNumber;
+        case Value::STRING:     return a_value.sString.empty() ? 0 : std::strtod(a_value.sString.c_str(), nullptr);
+        case Value::NULL_VALUE: return 0;
+        default:                return 0.0 / 0.0;
+    }
+}
+
+inline bool toBool(const Value& a_value) {
+    switch (a_value.nType) {
+        case Value::BOOLEAN:
+        case Value::NUMBER:     return a_value.fNumber != 0 && a_value.fNumber == a_value.fNumber;
+        case Value::STRING:     return !a_value.sString.empty();
+        case Value::OBJECT:     return true;
+        default:                return false;
+    }
+}
+
+inline bool strictlyEquals(const Value& a_a, const Value& a_b) {
+    if (a_a.nType != a_b.nType) {
+        return false;
+    }
+    switch (a_a.nType) {
+        case Value::BOOLEAN:
+        case Value::NUMBER:     return a_a.fNumber == a_b.fNumber;
+        case Value::STRING:     return a_a.sString == a_b.sString;
+        case Value::OBJECT:     return a_a.pObject == a_b.pObject;
+        default:                return true;
+    }
+}
+
+// ============================================================================
+// DOM
+// ============================================================================
+
+struct Object {
+    enum EKind { PLAIN, FUNCTION, DOCUMENT, ELEMENT, TEXT, STYLE, CLASS_LIST, CHILD_NODES };
+
+    EKind                                   nKind = PLAIN;
+    int                                     nSerial = 0;        // Creation order of elements and text nodes
+    std::string                             sName;              // Tag of an ELEMENT, name of a FUNCTION
+    std::map<std::string, Value>            properties;         // Own properties, expandos included
+    std::vector<std::pair<std::string, std::string>>
+                                            attributes;         // ELEMENT, class and style live in their objects
+    std::vector<std::shared_ptr<Object>>    children;           // ELEMENT and DOCUMENT
+    Object*                                 pParent = nullptr;
+    std::string                             sNodeValue;         // TEXT
+    std::shared_ptr<Object>                 pStyle;             // ELEMENT, created on first read
+    std::shared_ptr<Object>                 pClassList;         // ELEMENT, created on first read
+    std::vector<std::pair<std::string, std::string>>
+                                            styleProperties;    // STYLE
+    std::vector<std::string>                classTokens;        // CLASS_LIST
+    std::shared_ptr<Object>                 pOwner;             // CHILD_NODES: the element listed
+    std::vector<std::pair<std::string, std::shared_ptr<Object>>>
+                                            listeners;          // ELEMENT, event type and handler
+};
+
+// DOM writes since the last reset, what a change to the reconciler must not silently inflate
+struct DomCounts {
+    int nCreated = 0;       // createElement, createTextNode
+    int nInserted = 0;      // appendChild/insertBefore of a node without a parent
+    int nMoved = 0;         // appendChild/insertBefore of a node that had a parent
+    int nRemoved = 0;       // removeChild, innerHTML = ""
+    int nAttributes = 0;    // setAttribute, removeAttribute, toggleAttribute
+    int nProperties = 0;    // Own property writes on elements, __ expandos excluded
+    int nStyles = 0;        // setProperty, removeProperty, cssText
+    int nClasses = 0;       // classList.add/remove, className
+    int nTexts = 0;         // nodeValue writes
+    int nListeners = 0;     // addEventListener, removeEventListener
+
+    std::string toString() const {
+        return "created=" + std::to_string(nCreated) + " inserted=" + std::to_string(nInserted) +
+               " moved=" + std::to_string(nMoved) + " removed=" + std::to_string(nRemoved) +
+               " attributes=" + std::to_string(nAttributes) + " properties=" + std::to_string(nProperties) +
+               " styles=" + std::to_string(nStyles) + " classes=" + std::to_string(nClasses) +
+               " texts=" + std::to_string(nTexts) + " listeners=" + std::to_string(nListeners);
+    }
+};
+
+inline DomCounts g_domCounts;
+inline int g_nNextSerial = 1;
+
+inline std::shared_ptr<Object> makeObject(Object::EKind a_nKind, std::string a_sName = std::string()) {
+    auto pObject = std::make_shared<Object>();
+    pObject->nKind = a_nKind;
+    pObject->sName = std::move(a_sName);
+    if (a_nKind == Object::ELEMENT || a_nKind == Object::TEXT) {
+        pObject->nSerial = g_nNextSerial++;
+        ++g_domCounts.nCreated;
+    }
+    return pObject;
+}
+
+inline std::shared_ptr<Object>& document() {
+    static std::shared_ptr<Object> s_pDocument = [] {
+        auto pDocument = std::make_shared<Object>();
+        pDocument->nKind = Object::DOCUMENT;
+        auto pBody = std::make_shared<Object>();
+        pBody->nKind = Object::ELEMENT;
+        pBody->sName = "body";
+        pBody->pParent = pDocument.get();
+        pDocument->children.push_back(pBody);
+        return pDocument;
+    }();
+    return s_pDocument;
+}
+
+inline std::shared_ptr<Object> body() { return document()->children.front(); }
+
+// Stable functions, as Module properties are
+inline Value functionNamed(const std::string& a_sName) {
+    static std::map<std::string, std::shared_ptr<Object>> s_functions;
+    std::shared_ptr<Object>& pFunction = s_functions[a_sName];
+    if (!pFunction) {
+        pFunction = makeObject(Object::FUNCTION, a_sName);
+    }
+    return Value::object(pFunction);
+}
+
+inline std::vector<std::string> splitTokens(std::string_view a_sText) {
+    std::vector<std::string> tokens;
+    size_t i = 0;
+    while (i < a_sText.size()) {
+        while (i < a_sText.size() && a_sText[i] == ' ') {
+            ++i;
+        }
+        size_t nStart = i;
+        while (i < a_sText.size() && a_sText[i] != ' ') {
+            ++i;
+        }
+        if (i > nStart) {
+            tokens.emplace_back(a_sText.substr(nStart, i - nStart));
+        }
+    }
+    return tokens;
+}
+
+inline std::string trim(std::string_view a_sText) {
+    size_t nStart = a_sText.find_first_not_of(' ');
+    if (nStart == std::string_view::npos) {
+        return std::string();
+    }
+    return std::string(a_sText.substr(nStart, a_sText.find_last_not_of(' ') - nStart + 1));
+}
+
+inline std::shared_ptr<Object>& styleOf(Object& a_element) {
+    if (!a_element.pStyle) {
+        a_element.pStyle = makeObject(Object::STYLE);
+    }
+    return a_element.pStyle;
+}
+
+inline std::shared_ptr<Object>& classListOf(Object& a_element) {
+    if (!a_element.pClassList) {
+        a_element.pClassList = makeObject(Object::CLASS_LIST);
+    }
+    return a_element.pClassList;
+}
+
+inline void setStyleProperty(Object& a_style, const std::string& a_sProperty, const std::string& a_sValue) {
+    for (auto& [sProperty, sValue] : a_style.styleProperties) {
+        if (sProperty == a_sProperty) {
+            sValue = a_sValue;
+            return;
+        }
+    }
+    a_style.styleProperties.push_back({a_sProperty, a_sValue});
+}
+
+inline void removeStyleProperty(Object& a_style, const std::string& a_sProperty) {
+    auto& props = a_style.styleProperties;
+    props.erase(std::remove_if(props.begin(), props.end(), [&](const auto& a_prop) { return a_prop.first == a_sProperty; }), props.end());
+}
+
+inline void setCssText(Object& a_style, std::string_view a_sCssText) {
+    a_style.styleProperties.clear();
+    size_t nStart = 0;
+    while (nStart < a_sCssText.size()) {
+        size_t nEnd = a_sCssText.find(';', nStart);
+        std::string_view sDeclaration = a_sCssText.substr(nStart, nEnd == std::string_view::npos ? std::string_view::npos : nEnd - nStart);
+        size_t nColon = sDeclaration.find(':');
+        if (nColon != std::string_view::npos) {
+            std::string sProperty = trim(sDeclaration.substr(0, nColon));
+            std::string sValue = trim(sDeclaration.substr(nColon + 1));
+            if (!sProperty.empty() && !sValue.empty()) {
+                setStyleProperty(a_style, sProperty, sValue);
+            }
+        }
+        if (nEnd == std::string_view::npos) {
+            break;
+        }
+        nStart = nEnd + 1;
+    }
+}
+
+inline std::string cssText(const Object& a_style) {
+    std::string sText;
+    for (const auto& [sProperty, sValue] : a_style.styleProperties) {
+        if (!sText.empty()) {
+            sText += ' ';
+        }
+        sText += sProperty + ": " + sValue + ";";
+    }
+    return sText;
+}
+
+inline std::string className(Object& a_element) {
+    std::string sText;
+    for (const std::string& sToken : classListOf(a_element)->classTokens) {
+        if (!sText.empty()) {
+            sText += ' ';
+        }
+        sText += sToken;
+    }
+    return sText;
+}
+
+inline void setAttribute(Object& a_element, const std::string& a_sName, const std::string& a_sValue) {
+    if (a_sName == "class") {
+        classListOf(a_element)->classTokens = splitTokens(a_sValue);
+        return;
+    }
+    if (a_sName == "style") {
+        setCssText(*styleOf(a_element), a_sValue);
+        return;
+    }
+    for (auto& [sName, sValue] : a_element.attributes) {
+        if (sName == a_sName) {
+            sValue = a_sValue;
+            return;
+        }
+    }
+    a_element.attributes.push_back({a_sName, a_sValue});
+}
+
+inline void removeAttribute(Object& a_element, const std::string& a_sName) {
+    if (a_sName == "class") {
+        classListOf(a_element)->classTokens.clear();
+        return;
+    }
+    if (a_sName == "style") {
+        styleOf(a_element)->styleProperties.clear();
+        return;
+    }
+    auto& attrs = a_element.attributes;
+    attrs.erase(std::remove_if(attrs.begin(), attrs.end(), [&](const auto& a_attr) { return a_attr.first == a_sName; }), attrs.end());
+}
+
+inline bool hasAttribute(const Object& a_element, const std::string& a_sName) {
+    for (const auto& [sName, sValue] : a_element.attributes) {
+        if (sName == a_sName) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void detach(Object& a_node) {
+    if (a_node.pParent == nullptr) {
+        return;
+    }
+    auto& siblings = a_node.pParent->children;
+    siblings.erase(std::find_if(siblings.begin(), siblings.end(), [&](const auto& p) { return p.get() == &a_node; }));
+    a_node.pParent = nullptr;
+}
+
+inline void insertChild(Object& a_parent, const std::shared_ptr<Object>& a_pChild, const Object* a_pReference) {
+    if (a_pChild->pParent != nullptr) {
+        ++g_domCounts.nMoved;
+        detach(*a_pChild);
+    } else {
+        ++g_domCounts.nInserted;
+    }
+    auto it = a_parent.children.end();
+    if (a_pReference != nullptr) {
+        it = std::find_if(a_parent.children.begin(), a_parent.children.end(), [&](const auto& p) { return p.get() == a_pReference; });
+    }
+    a_parent.children.insert(it, a_pChild);
+    a_pChild->pParent = &a_parent;
+}
+
+inline std::shared_ptr<Object> findById(const std::shared_ptr<Object>& a_pNode, const std::string& a_sId) {
+    if (a_pNode->nKind == Object::ELEMENT) {
+        for (const auto& [sName, sValue] : a_pNode->attributes) {
+            if (sName == "id" && sValue == a_sId) {
+                return a_pNode;
+            }
+        }
+    }
+    for (const auto& pChild : a_pNode->children) {
+        if (auto pFound = findById(pChild, a_sId)) {
+            return pFound;
+        }
+    }
+    return nullptr;
+}
+
+inline Value getProperty(const Value& a_self, const Value& a_key) {
+    if (a_self.nType != Value::OBJECT) {
+        if (a_self.nType == Value::STRING && toString(a_key) == "length") {
+            return Value::number(static_cast<double>(a_self.sString.size()));
+        }
+        return Value();
+    }
+    Object& self = *a_self.pObject;
+    std::string sKey = toString(a_key);
+    switch (self.nKind) {
+        case Object::DOCUMENT:
+            if (sKey == "body") {
+                return Value::object(body());
+            }
+            break;
+        case Object::ELEMENT:
+            if (sKey == "style") {
+                return Value::object(styleOf(self));
+            }
+            if (sKey == "classList") {
+                return Value::object(classListOf(self));
+            }
+            if (sKey == "className") {
+                return Value::string(className(self));
+            }
+            if (sKey == "childNodes") {
+                auto pList = makeObject(Object::CHILD_NODES);
+                pList->pOwner = a_self.pObject;
+                return Value::object(pList);
+            }
+            if (sKey == "tagName") {
+                return Value::string(self.sName);
+            }
+            break;
+        case Object::TEXT:
+            if (sKey == "nodeValue" || sKey == "data" || sKey == "textContent") {
+                return Value::string(self.sNodeValue);
+            }
+            break;
+        case Object::STYLE:
+            if (sKey == "cssText") {
+                return Value::string(cssText(self));
+            }
+            break;
+        case Object::CHILD_NODES:
+            if (sKey == "length") {
+                return Value::number(static_cast<double>(self.pOwner->children.size()));
+            }
+            if (a_key.nType == Value::NUMBER) {
+                size_t nIdx = static_cast<size_t>(a_key.fNumber);
+                return nIdx < self.pOwner->children.size() ? Value::object(self.pOwner->children[nIdx]) : Value();
+            }
+            break;
+        default:
+            break;
+    }
+    auto it = self.properties.find(sKey);
+    return it != self.properties.end() ? it->second : Value();
+}
+
+inline void setProperty(const Value& a_self, const Value& a_key, const Value& a_value) {
+    if (a_self.nType != Value::OBJECT) {
+        return;
+    }
+    Object& self = *a_self.pObject;
+    std::string sKey = toString(a_key);
+    switch (self.nKind) {
+        case Object::ELEMENT:
+            if (sKey == "className") {
+                ++g_domCounts.nClasses;
+                classListOf(self)->classTokens = splitTokens(toString(a_value));
+                return;
+            }
+            if (sKey == "innerHTML") {
+                for (auto& pChild : self.children) {
+                    pChild->pParent = nullptr;
+                    ++g_domCounts.nRemoved;
+                }
+                self.children.clear();
+                return;
+            }
+            if (sKey.rfind("__", 0) != 0) {
+                ++g_domCounts.nProperties;
+            }
+            break;
+        case Object::TEXT:
+            if (sKey == "nodeValue" || sKey == "data" || sKey == "textContent") {
+                ++g_domCounts.nTexts;
+                self.sNodeValue = toString(a_value);
+                return;
+            }
+            break;
+        case Object::STYLE:
+            if (sKey == "cssText") {
+                ++g_domCounts.nStyles;
+                setCssText(self, toString(a_value));
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+    self.properties[sKey] = a_value;
+}
+
+inline Value argument(const std::vector<Value>& a_args, size_t a_nIdx) {
+    return a_nIdx < a_args.size() ? a_args[a_nIdx] : Value();
+}
+
+inline Value invoke(const Value& a_self, const std::string& a_sMethod, const std::vector<Value>& a_args) {
+    if (a_self.nType != Value::OBJECT) {
+        return Value();
+    }
+    Object& self = *a_self.pObject;
+    std::string sArg0 = toString(argument(a_args, 0));
+    switch (self.nKind) {
+        case Object::DOCUMENT:
+            if (a_sMethod == "createElement") {
+                return Value::object(makeObject(Object::ELEMENT, sArg0));
+            }
+            if (a_sMethod == "createTextNode") {
+                auto pText = makeObject(Object::TEXT);
+                pText->sNodeValue = sArg0;
+                return Value::object(pText);
+            }
+            if (a_sMethod == "getElementById") {
+                auto pFound = findById(body(), sArg0);
+                return pFound ? Value::object(pFound) : Value::null();
+            }
+            break;
+        case Object::ELEMENT:
+            if (a_sMethod == "setAttribute") {
+                ++g_domCounts.nAttributes;
+                setAttribute(self, sArg0, toString(argument(a_args, 1)));
+            } else if (a_sMethod == "removeAttribute") {
+                ++g_domCounts.nAttributes;
+                removeAttribute(self, sArg0);
+            } else if (a_sMethod == "toggleAttribute") {
+                ++g_domCounts.nAttributes;
+                bool bForce = a_args.size() > 1 ? toBool(a_args[1]) : !hasAttribute(self, sArg0);
+                if (bForce) {
+                    setAttribute(self, sArg0, "");
+                } else {
+                    removeAttribute(self, sArg0);
+                }
+                return Value::boolean(bForce);
+            } else if (a_sMethod == "getAttribute") {
+                for (const auto& [sName, sValue] : self.attributes) {
+                    if (sName == sArg0) {
+                        return Value::string(sValue);
+                    }
+                }
+                return Value::null();
+            } else if (a_sMethod == "appendChild") {
+                insertChild(self, argument(a_args, 0).pObject, nullptr);
+            } else if (a_sMethod == "insertBefore") {
+                insertChild(self, argument(a_args, 0).pObject, argument(a_args, 1).pObject.get());
+            } else if (a_sMethod == "removeChild") {
+                ++g_domCounts.nRemoved;
+                detach(*argument(a_args, 0).pObject);
+            } else if (a_sMethod == "replaceChild") {
+                Value hOld = argument(a_args, 1);
+                insertChild(self, argument(a_args, 0).pObject, hOld.pObject.get());
+                ++g_domCounts.nRemoved;
+                detach(*hOld.pObject);
+            } else if (a_sMethod == "addEventListener" || a_sMethod == "removeEventListener") {
+                ++g_domCounts.nListeners;
+                std::pair<std::string, std::shared_ptr<Object>> listener{sArg0, argument(a_args, 1).pObject};
+                auto it = std::find(self.listeners.begin(), self.listeners.end(), listener);
+                if (a_sMethod == "addEventListener" && it == self.listeners.end()) {
+                    self.listeners.push_back(listener);
+                } else if (a_sMethod == "removeEventListener" && it != self.listeners.end()) {
+                    self.listeners.erase(it);
+                }
+            }
+            return Value();
+        case Object::STYLE:
+            if (a_sMethod == "setProperty") {
+                ++g_domCounts.nStyles;
+                setStyleProperty(self, sArg0, toString(argument(a_args, 1)));
+            } else if (a_sMethod == "removeProperty") {
+                ++g_domCounts.nStyles;
+                removeStyleProperty(self, sArg0);
+            }
+            return Value();
+        case Object::CLASS_LIST:
+            if (a_sMethod == "add" || a_sMethod == "remove") {
+                ++g_domCounts.nClasses;
+                auto& tokens = self.classTokens;
+                auto it = std::find(tokens.begin(), tokens.end(), sArg0);
+                if (a_sMethod == "add" && it == tokens.end()) {
+                    tokens.push_back(sArg0);
+                } else if (a_sMethod == "remove" && it != tokens.end()) {
+                    tokens.erase(it);
+                }
+            } else if (a_sMethod == "contains") {
+                return Value::boolean(std::find(self.classTokens.begin(), self.classTokens.end(), sArg0) != self.classTokens.end());
+            }
+            return Value();
+        default:
+            break;
+    }
+    return Value();
+}
+
+// ============================================================================
+// Markup
+// ============================================================================
+// Attributes sorted by name, class tokens and style properties sorted too:
+// their DOM order depends on the order of the writes, not on the result.
+
+inline void appendEscaped(std::string& a_sOut, std::string_view a_sText, bool a_bAttribute) {
+    for (char c : a_sText) {
+        switch (c) {
+            case '&': a_sOut += "&amp;"; break;
+            case '<': a_sOut += "&lt;"; break;
+            case '>': a_sOut += "&gt;"; break;
+            case '"': a_sOut += a_bAttribute ? "&quot;" : "\""; break;
+            default:  a_sOut += c; break;
+        }
+    }
+}
+
+inline void appendMarkup(std::string& a_sOut, Object& a_node) {
+    if (a_node.nKind == Object::TEXT) {
+        appendEscaped(a_sOut, a_node.sNodeValue, false);
+        return;
+    }
+    std::vector<std::pair<std::string, std::string>> attrs = a_node.attributes;
+    if (a_node.pClassList && !a_node.pClassList->classTokens.empty()) {
+        std::vector<std::string> tokens = a_node.pClassList->classTokens;
+        std::sort(tokens.begin(), tokens.end());
+        std::string sClass;
+        for (const std::string& sToken : tokens) {
+            sClass += (sClass.empty() ? "" : " ") + sToken;
+        }
+        attrs.push_back({"class", sClass});
+    }
+    if (a_node.pStyle && !a_node.pStyle->styleProperties.empty()) {
+        Object style = *a_node.pStyle;
+        std::sort(style.styleProperties.begin(), style.styleProperties.end());
+        attrs.push_back({"style", cssText(style)});
+    }
+    std::sort(attrs.begin(), attrs.end());
+
+    a_sOut += '<';
+    a_sOut += a_node.sName;
+    for (const auto& [sName, sValue] : attrs) {
+        a_sOut += ' ';
+        a_sOut += sName;
+        a_sOut += "=\"";
+        appendEscaped(a_sOut, sValue, true);
+        a_sOut += '"';
+    }
+    a_sOut += '>';
+    for (const auto& pChild : a_node.children) {
+        appendMarkup(a_sOut, *pChild);
+    }
+    a_sOut += "</";
+    a_sOut += a_node.sName;
+    a_sOut += '>';
+}
+
+// ============================================================================
+// Handles
+// ============================================================================
+// Ids 1-4 are undefined, null, true and false and are never freed. Freed ids
+// are reused, like Emval's, so a stale handle shows up as a wrong value.
+
+constexpr uint32_t HANDLE_UNDEFINED = 1;
+constexpr uint32_t HANDLE_NULL = 2;
+constexpr uint32_t HANDLE_TRUE = 3;
+constexpr uint32_t HANDLE_FALSE = 4;
+constexpr uint32_t HANDLE_FIRST = 5;
+
+struct HandleTable {
+    std::vector<Value>      values = std::vector<Value>(HANDLE_FIRST);
+    std::vector<uint32_t>   refs = std::vector<uint32_t>(HANDLE_FIRST, 1);
+    std::vector<uint32_t>   freeIds;
+    size_t                  nLive = 0;
+};
+
+inline HandleTable& handles() {
+    static HandleTable s_table = [] {
+        HandleTable table;
+        table.values[HANDLE_NULL] = Value::null();
+        table.values[HANDLE_TRUE] = Value::boolean(true);
+        table.values[HANDLE_FALSE] = Value::boolean(false);
+        return table;
+    }();
+    return s_table;
+}
+
+inline uint32_t handleId(emscripten::EM_VAL a_hValue) {
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(a_hValue));
+}
+
+inline emscripten::EM_VAL toHandle(Value a_value) {
+    HandleTable& table = handles();
+    uint32_t nId;
+    switch (a_value.nType) {
+        case Value::UNDEFINED:  nId = HANDLE_UNDEFINED; break;
+        case Value::NULL_VALUE: nId = HANDLE_NULL; break;
+        case Value::BOOLEAN:    nId = a_value.fNumber != 0 ? HANDLE_TRUE : HANDLE_FALSE; break;
+        default:
+            if (!table.freeIds.empty()) {
+                nId = table.freeIds.back();
+                table.freeIds.pop_back();
+                table.values[nId] = std::move(a_value);
+                table.refs[nId] = 1;
+            } else {
+                nId = static_cast<uint32_t>(table.values.size());
+                table.values.push_back(std::move(a_value));
+                table.refs.push_back(1);
+            }
+            ++table.nLive;
+            break;
+    }
+    return reinterpret_cast<emscripten::EM_VAL>(static_cast<uintptr_t>(nId));
+}
+
+inline const Value& toValue(emscripten::EM_VAL a_hValue) {
+    uint32_t nId = handleId(a_hValue);
+    HandleTable& table = handles();
+    return nId != 0 && nId < table.values.size() ? table.values[nId] : table.values[HANDLE_UNDEFINED];
+}
+
+inline void incref(emscripten::EM_VAL a_hValue) {
+    uint32_t nId = handleId(a_hValue);
+    if (nId >= HANDLE_FIRST) {
+        ++handles().refs[nId];
+    }
+}
+
+inline void decref(emscripten::EM_VAL a_hValue) {
+    uint32_t nId = handleId(a_hValue);
+    HandleTable& table = handles();
+    if (nId >= HANDLE_FIRST && --table.refs[nId] == 0) {
+        table.values[nId] = Value();
+        table.freeIds.push_back(nId);
+        --table.nLive;
+    }
+}
+
+// Handles not released yet, for leak checks
+inline size_t liveHandles() { return handles().nLive; }
+
+} // namespace volt_stub
+
+namespace emscripten {
+
+namespace internal {
+    inline void _emval_incref(EM_VAL a_hValue) { volt_stub::incref(a_hValue); }
+    inline void _emval_decref(EM_VAL a_hValue) { volt_stub::decref(a_hValue); }
+}
+
+class val;
+
+namespace internal {
+    template<typename T> volt_stub::Value toValue(T&& a_value);
+}
+
+class val {
+public:
+    val() noexcept : m_hHandle(handleOf(volt_stub::HANDLE_UNDEFINED)) {}
+    val(const val& a_other) : m_hHandle(a_other.m_hHandle) { volt_stub::incref(m_hHandle); }
+    val(val&& a_other) noexcept : m_hHandle(a_other.m_hHandle) { a_other.m_hHandle = handleOf(volt_stub::HANDLE_UNDEFINED); }
+    ~val() { volt_stub::decref(m_hHandle); }
+
+    val& operator=(const val& a_other) {
+        volt_stub::incref(a_other.m_hHandle);
+        volt_stub::decref(m_hHandle);
+        m_hHandle = a_other.m_hHandle;
+        return *this;
+    }
+    val& operator=(val&& a_other) noexcept {
+        if (this != &a_other) {
+            volt_stub::decref(m_hHandle);
+            m_hHandle = a_other.m_hHandle;
+            a_other.m_hHandle = handleOf(volt_stub::HANDLE_UNDEFINED);
+        }
+        return *this;
+    }
+
+    template<typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, val>>>
+    explicit val(T&& a_value) : m_hHandle(volt_stub::toHandle(internal::toValue(std::forward<T>(a_value)))) {}
+
+    static val global(const char* a_sName = nullptr) {
+        if (a_sName != nullptr && std::string_view(a_sName) == "document") {
+            return fromValue(volt_stub::Value::object(volt_stub::document()));
+        }
+        return object();
+    }
+    static val undefined() { return val(); }
+    static val null() { return fromValue(volt_stub::Value::null()); }
+    static val object() { return fromValue(volt_stub::Value::object(volt_stub::makeObject(volt_stub::Object::PLAIN))); }
+    static val array() { return object(); }
+    static val u8string(const char* a_sText) { return fromValue(volt_stub::Value::string(a_sText)); }
+    static val module_property(const char* a_sName) { return fromValue(volt_stub::functionNamed(a_sName)); }
+    static val take_ownership(EM_VAL a_hValue) { val v; v.m_hHandle = a_hValue; return v; }
+
+    template<typename R = void, typename... Args>
+    R call(const char* a_sMethod, Args&&... a_args) const {
+        std::vector<volt_stub::Value> args{internal::toValue(std::forward<Args>(a_args))...};
+        val result = fromValue(volt_stub::invoke(value(), a_sMethod, args));
+        if constexpr (!std::is_void_v<R>) {
+            if constexpr (std::is_same_v<R, val>) {
+                return result;
+            } else {
+                return result.as<R>();
+            }
+        }
+    }
+
+    template<typename K, typename V> void set(const K& a_key, const V& a_value) const {
+        volt_stub::setProperty(value(), internal::toValue(a_key), internal::toValue(a_value));
+    }
+    template<typename K> val operator[](const K& a_key) const {
+        return fromValue(volt_stub::getProperty(value(), internal::toValue(a_key)));
+    }
+
+    template<typename T> T as() const {
+        const volt_stub::Value& v = value();
+        if constexpr (std::is_same_v<T, std::string>) {
+            return volt_stub::toString(v);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return volt_stub::toBool(v);
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            return static_cast<T>(volt_stub::toNumber(v));
+        } else {
+            return T();
+        }
+    }
+
+    template<typename... Args> val operator()(Args&&...) const { return val(); }
+    template<typename... Args> val new_(Args&&...) const { return object(); }
+    template<typename K> bool hasOwnProperty(const K& a_key) const {
+        const volt_stub::Value& v = value();
+        return v.nType == volt_stub::Value::OBJECT && v.pObject->properties.count(volt_stub::toString(internal::toValue(a_key))) > 0;
+    }
+    template<typename K> void delete_(const K& a_key) const {
+        const volt_stub::Value& v = value();
+        if (v.nType == volt_stub::Value::OBJECT) {
+            v.pObject->properties.erase(volt_stub::toString(internal::toValue(a_key)));
+        }
+    }
+
+    bool isNull() const { return value().nType == volt_stub::Value::NULL_VALUE; }
+    bool isUndefined() const { return value().nType == volt_stub::Value::UNDEFINED; }
+    bool isString() const { return value().nType == volt_stub::Value::STRING; }
+    bool isNumber() const { return value().nType == volt_stub::Value::NUMBER; }
+    bool isTrue() const { return value().nType == volt_stub::Value::BOOLEAN && value().fNumber != 0; }
+    std::string typeOf() const {
+        switch (value().nType) {
+            case volt_stub::Value::UNDEFINED: return "undefined";
+            case volt_stub::Value::BOOLEAN:   return "boolean";
+            case volt_stub::Value::NUMBER:    return "number";
+            case volt_stub::Value::STRING:    return "string";
+            case volt_stub::Value::OBJECT:    return value().pObject->nKind == volt_stub::Object::FUNCTION ? "function" : "object";
+            default:                          return "object";
+        }
+    }
+
+    EM_VAL as_handle() const { return m_hHandle; }
+    EM_VAL release_ownership() { EM_VAL hValue = m_hHandle; m_hHandle = handleOf(volt_stub::HANDLE_UNDEFINED); return hValue; }
+
+    // JS ==, null and undefined are loosely equal
+    bool operator==(const val& a_other) const {
+        return volt_stub::strictlyEquals(value(), a_other.value()) || ((isNull() || isUndefined()) && (a_other.isNull() || a_other.isUndefined()));
+    }
+    bool operator!=(const val& a_other) const { return !(*this == a_other); }
+    bool strictlyEquals(const val& a_other) const { return volt_stub::strictlyEquals(value(), a_other.value()); }
+
+    const volt_stub::Value& value() const { return volt_stub::toValue(m_hHandle); }
+    static val fromValue(volt_stub::Value a_value) { return take_ownership(volt_stub::toHandle(std::move(a_value))); }
+
+private:
+    static EM_VAL handleOf(uint32_t a_nId) { return reinterpret_cast<EM_VAL>(static_cast<uintptr_t>(a_nId)); }
+
+    EM_VAL m_hHandle;
+};
+
+namespace internal {
+    template<typename T> volt_stub::Value toValue(T&& a_value) {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, val>) {
+            return a_value.value();
+        } else if constexpr (std::is_same_v<U, volt_stub::Value>) {
+            return a_value;
+        } else if constexpr (std::is_same_v<U, bool>) {
+            return volt_stub::Value::boolean(a_value);
+        } else if constexpr (std::is_arithmetic_v<U>) {
+            return volt_stub::Value::number(static_cast<double>(a_value));
+        } else if constexpr (std::is_pointer_v<U> && !std::is_same_v<U, const char*> && !std::is_same_v<U, char*>) {
+            return volt_stub::Value::number(static_cast<double>(reinterpret_cast<uintptr_t>(a_value)));
+        } else {
+            return volt_stub::Value::string(std::string(a_value));
+        }
+    }
+}
+
+template<typename T>
+std::vector<T> vecFromJSArray(const val&) { return {}; }
+
+} // namespace emscripten
@@ -0,0 +1,4 @@
+#pragma once
+
+// Native stand-in for <emscripten.h>, see bench/README.md
+#include <emscripten/emscripten.h>
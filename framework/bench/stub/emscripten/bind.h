@@ -0,0 +1,12 @@
+#pragma once
+
+// Native stand-in for <emscripten/bind.h>: bindings are never registered
+#include <emscripten/val.h>
+
+namespace emscripten {
+    struct allow_raw_pointers {};
+    template<typename F, typename... Policies>
+    void function(const char*, F, Policies...) {}
+}
+
+#define EMSCRIPTEN_BINDINGS(name) [[maybe_unused]] static void volt_stub_bindings_##name()
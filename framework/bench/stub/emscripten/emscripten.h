@@ -0,0 +1,48 @@
+#pragma once
+
+// ============================================================================
+// Native stand-in for the Emscripten runtime
+// ============================================================================
+// Just enough for the non-DOM core to compile and run on the host:
+// JS bridges return a default value, the clock is the host's steady clock.
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+
+// EM_JS functions become no-ops returning a default value
+#define EM_JS(ret, name, params, ...) inline ret name params { return ret(); }
+#define EM_ASM(...) ((void)0)
+#define EM_ASM_INT(...) 0
+#define EM_ASM_DOUBLE(...) 0.0
+#define EMSCRIPTEN_KEEPALIVE
+
+typedef int EM_BOOL;
+#define EM_TRUE 1
+#define EM_FALSE 0
+
+#define EM_LOG_CONSOLE 1
+#define EM_LOG_WARN    2
+#define EM_LOG_ERROR   4
+#define EM_LOG_INFO    512
+
+// Warnings and errors still reach stderr, a benchmark that logs is measuring the log
+inline void emscripten_log(int a_nFlags, const char* a_sFormat, ...) {
+    if ((a_nFlags & (EM_LOG_WARN | EM_LOG_ERROR)) == 0) {
+        return;
+    }
+    va_list args;
+    va_start(args, a_sFormat);
+    std::vfprintf(stderr, a_sFormat, args);
+    std::fputc('\n', stderr);
+    va_end(args);
+}
+
+inline double emscripten_get_now() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+inline double emscripten_performance_now() {
+    return emscripten_get_now();
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+// Native stand-in for <emscripten/html5.h>: the benchmark drives animation frames itself
+#include <emscripten/emscripten.h>
+
+namespace volt_stub {
+    inline EM_BOOL (*g_pFrameCallback)(double, void*) = nullptr;
+    inline void* g_pFrameUserData = nullptr;
+
+    // Runs the pending requestAnimationFrame callback, if any
+    inline bool runAnimationFrame() {
+        auto pCallback = g_pFrameCallback;
+        if (pCallback == nullptr) {
+            return false;
+        }
+        g_pFrameCallback = nullptr;
+        pCallback(emscripten_get_now(), g_pFrameUserData);
+        return true;
+    }
+}
+
+inline long emscripten_request_animation_frame(EM_BOOL (*a_pCallback)(double, void*), void* a_pUserData) {
+    volt_stub::g_pFrameCallback = a_pCallback;
+    volt_stub::g_pFrameUserData = a_pUserData;
+    return 1;
+}
+
+inline void emscripten_cancel_animation_frame(long) {
+    volt_stub::g_pFrameCallback = nullptr;
+}
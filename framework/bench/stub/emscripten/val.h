@@ -0,0 +1,82 @@
+#pragma once
+
+// ============================================================================
+// Native stand-in for emscripten::val
+// ============================================================================
+// A handle that only remembers whether it is undefined, null or an object.
+// Every JS object is the same empty object: calls and property writes do
+// nothing, reads return an object or a default-constructed value.
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+namespace emscripten {
+
+struct _EM_VAL;
+typedef _EM_VAL* EM_VAL;
+
+namespace internal {
+    inline void _emval_incref(EM_VAL) {}
+    inline void _emval_decref(EM_VAL) {}
+}
+
+class val {
+public:
+    val() noexcept = default;
+
+    template<typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, val>>>
+    explicit val(T&&) noexcept : m_nKind(OBJECT) {}
+
+    static val global(const char* = nullptr) { return object(); }
+    static val undefined() { return val(); }
+    static val null() { return val(NULL_VALUE); }
+    static val object() { return val(OBJECT); }
+    static val array() { return val(OBJECT); }
+    static val u8string(const char*) { return val(OBJECT); }
+    static val module_property(const char*) { return val(OBJECT); }
+    static val take_ownership(EM_VAL) { return val(OBJECT); }
+
+    template<typename R = void, typename... Args>
+    R call(const char*, Args&&...) const {
+        if constexpr (std::is_same_v<R, val>) {
+            return object();
+        } else if constexpr (!std::is_void_v<R>) {
+            return R();
+        }
+    }
+
+    template<typename K, typename V> void set(const K&, const V&) const {}
+    template<typename K> val operator[](const K&) const { return object(); }
+    template<typename T> T as() const { return T(); }
+    template<typename... Args> val operator()(Args&&...) const { return val(); }
+    template<typename... Args> val new_(Args&&...) const { return object(); }
+    template<typename K> bool hasOwnProperty(const K&) const { return false; }
+    template<typename K> void delete_(const K&) const {}
+
+    bool isNull() const { return m_nKind == NULL_VALUE; }
+    bool isUndefined() const { return m_nKind == UNDEFINED; }
+    bool isString() const { return false; }
+    bool isNumber() const { return false; }
+    bool isTrue() const { return false; }
+    std::string typeOf() const { return m_nKind == UNDEFINED ? "undefined" : "object"; }
+
+    EM_VAL as_handle() const { return nullptr; }
+    EM_VAL release_ownership() { return nullptr; }
+
+    bool operator==(const val& a_other) const { return m_nKind == a_other.m_nKind; }
+    bool operator!=(const val& a_other) const { return m_nKind != a_other.m_nKind; }
+    bool strictlyEquals(const val& a_other) const { return m_nKind == a_other.m_nKind; }
+
+private:
+    enum EKind { UNDEFINED, NULL_VALUE, OBJECT };
+    explicit val(EKind a_nKind) noexcept : m_nKind(a_nKind) {}
+
+    EKind m_nKind = UNDEFINED;
+};
+
+template<typename T>
+std::vector<T> vecFromJSArray(const val&) { return {}; }
+
+} // namespace emscripten
@@ -12,6 +12,9 @@ public:
     virtual ~App() = default;
     
     void invalidate() { m_runtime.invalidate(); }
+
+    // Start background work, e.g. spawn(aggregate()) with volt::Task aggregate()
+    void spawn(Task a_task) { m_runtime.spawn(std::move(a_task)); }
     
     // Get runtime pointer to pass child components
     IRuntime& getRuntime() { return m_runtime; }
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <array>
 #include <string>
+#include <string_view>
+#include <optional>
 #include <utility>
 #include <functional>
+#include <type_traits>
+#include "InplaceFunction.hpp"
+#include "String.hpp"
 
 namespace volt {
 
+class AnimatedBase;
+
 namespace attr {
 
 // ============================================================================
@@ -16,102 +24,123 @@ namespace attr {
 constexpr short ATTR_undefined = -1;
 
 // Bubble Events (0-99)
-constexpr short ATTR_EVT_onafterprint = 0; const char * SATTR_EVT_onafterprint = "afterprint";
-constexpr short ATTR_EVT_onbeforeprint = 1; const char * SATTR_EVT_onbeforeprint = "beforeprint";
-constexpr short ATTR_EVT_oncanplay = 2; const char * SATTR_EVT_oncanplay = "canplay";
-constexpr short ATTR_EVT_oncanplaythrough = 3; const char * SATTR_EVT_oncanplaythrough = "canplaythrough";
-constexpr short ATTR_EVT_onchange = 4; const char * SATTR_EVT_onchange = "change";
-constexpr short ATTR_EVT_onclick = 5; const char * SATTR_EVT_onclick = "click";
-constexpr short ATTR_EVT_oncontextmenu = 6; const char * SATTR_EVT_oncontextmenu = "contextmenu";
-constexpr short ATTR_EVT_oncopy = 7; const char * SATTR_EVT_oncopy = "copy";
-constexpr short ATTR_EVT_oncuechange = 8; const char * SATTR_EVT_oncuechange = "cuechange";
-constexpr short ATTR_EVT_oncut = 9; const char * SATTR_EVT_oncut = "cut";
-constexpr short ATTR_EVT_ondblclick = 10; const char * SATTR_EVT_ondblclick = "dblclick";
-constexpr short ATTR_EVT_ondrag = 11; const char * SATTR_EVT_ondrag = "drag";
-constexpr short ATTR_EVT_ondragend = 12; const char * SATTR_EVT_ondragend = "dragend";
-constexpr short ATTR_EVT_ondragenter = 13; const char * SATTR_EVT_ondragenter = "dragenter";
-constexpr short ATTR_EVT_ondragleave = 14; const char * SATTR_EVT_ondragleave = "dragleave";
-constexpr short ATTR_EVT_ondragover = 15; const char * SATTR_EVT_ondragover = "dragover";
-constexpr short ATTR_EVT_ondragstart = 16; const char * SATTR_EVT_ondragstart = "dragstart";
-constexpr short ATTR_EVT_ondrop = 17; const char * SATTR_EVT_ondrop = "drop";
-constexpr short ATTR_EVT_ondurationchange = 18; const char * SATTR_EVT_ondurationchange = "durationchange";
-constexpr short ATTR_EVT_onemptied = 19; const char * SATTR_EVT_onemptied = "emptied";
-constexpr short ATTR_EVT_onended = 20; const char * SATTR_EVT_onended = "ended";
-constexpr short ATTR_EVT_onfocusin = 21; const char * SATTR_EVT_onfocusin = "focusin";
-constexpr short ATTR_EVT_onfocusout = 22; const char * SATTR_EVT_onfocusout = "focusout";
-constexpr short ATTR_EVT_onhashchange = 23; const char * SATTR_EVT_onhashchange = "hashchange";
-constexpr short ATTR_EVT_oninput = 24; const char * SATTR_EVT_oninput = "input";
-constexpr short ATTR_EVT_oninvalid = 25; const char * SATTR_EVT_oninvalid = "invalid";
-constexpr short ATTR_EVT_onkeydown = 26; const char * SATTR_EVT_onkeydown = "keydown";
-constexpr short ATTR_EVT_onkeypress = 27; const char * SATTR_EVT_onkeypress = "keypress";
-constexpr short ATTR_EVT_onkeyup = 28; const char * SATTR_EVT_onkeyup = "keyup";
-constexpr short ATTR_EVT_onloadeddata = 29; const char * SATTR_EVT_onloadeddata = "loadeddata";
-constexpr short ATTR_EVT_onloadedmetadata = 30; const char * SATTR_EVT_onloadedmetadata = "loadedmetadata";
-constexpr short ATTR_EVT_onloadstart = 31; const char * SATTR_EVT_onloadstart = "loadstart";
-constexpr short ATTR_EVT_onmousedown = 34; const char * SATTR_EVT_onmousedown = "mousedown";
-constexpr short ATTR_EVT_onmousemove = 35; const char * SATTR_EVT_onmousemove = "mousemove";
-constexpr short ATTR_EVT_onmouseout = 36; const char * SATTR_EVT_onmouseout = "mouseout";
-constexpr short ATTR_EVT_onmouseover = 37; const char * SATTR_EVT_onmouseover = "mouseover";
-constexpr short ATTR_EVT_onmouseup = 38; const char * SATTR_EVT_onmouseup = "mouseup";
-constexpr short ATTR_EVT_onmousewheel = 39; const char * SATTR_EVT_onmousewheel = "mousewheel";
-constexpr short ATTR_EVT_onoffline = 40; const char * SATTR_EVT_onoffline = "offline";
-constexpr short ATTR_EVT_ononline = 41; const char * SATTR_EVT_ononline = "online";
-constexpr short ATTR_EVT_onpagehide = 42; const char * SATTR_EVT_onpagehide = "pagehide";
-constexpr short ATTR_EVT_onpageshow = 43; const char * SATTR_EVT_onpageshow = "pageshow";
-constexpr short ATTR_EVT_onpaste = 44; const char * SATTR_EVT_onpaste = "paste";
-constexpr short ATTR_EVT_onpause = 45; const char * SATTR_EVT_onpause = "pause";
-constexpr short ATTR_EVT_onplay = 46; const char * SATTR_EVT_onplay = "play";
-constexpr short ATTR_EVT_onplaying = 47; const char * SATTR_EVT_onplaying = "playing";
-constexpr short ATTR_EVT_onpointerover = 48; const char * SATTR_EVT_onpointerover = "pointerover";
-constexpr short ATTR_EVT_onpointerdown = 50; const char * SATTR_EVT_onpointerdown = "pointerdown";
-constexpr short ATTR_EVT_onpointermove = 51; const char * SATTR_EVT_onpointermove = "pointermove";
-constexpr short ATTR_EVT_onpointerup = 52; const char * SATTR_EVT_onpointerup = "pointerup";
-constexpr short ATTR_EVT_onpointercancel = 53; const char * SATTR_EVT_onpointercancel = "pointercancel";
-constexpr short ATTR_EVT_onpointerout = 54; const char * SATTR_EVT_onpointerout = "pointerout";
-constexpr short ATTR_EVT_onpointerrawupdate = 56; const char * SATTR_EVT_onpointerrawupdate = "pointerrawupdate";
-constexpr short ATTR_EVT_onpopstate = 59; const char * SATTR_EVT_onpopstate = "popstate";
-constexpr short ATTR_EVT_onprogress = 60; const char * SATTR_EVT_onprogress = "progress";
-constexpr short ATTR_EVT_onratechange = 61; const char * SATTR_EVT_onratechange = "ratechange";
-constexpr short ATTR_EVT_onreset = 62; const char * SATTR_EVT_onreset = "reset";
-constexpr short ATTR_EVT_onsearch = 63; const char * SATTR_EVT_onsearch = "search";
-constexpr short ATTR_EVT_onseeked = 64; const char * SATTR_EVT_onseeked = "seeked";
-constexpr short ATTR_EVT_onseeking = 65; const char * SATTR_EVT_onseeking = "seeking";
-constexpr short ATTR_EVT_onselect = 66; const char * SATTR_EVT_onselect = "select";
-constexpr short ATTR_EVT_onstalled = 67; const char * SATTR_EVT_onstalled = "stalled";
-constexpr short ATTR_EVT_onstorage = 68; const char * SATTR_EVT_onstorage = "storage";
-constexpr short ATTR_EVT_onsubmit = 69; const char * SATTR_EVT_onsubmit = "submit";
-constexpr short ATTR_EVT_onsuspend = 70; const char * SATTR_EVT_onsuspend = "suspend";
-constexpr short ATTR_EVT_ontimeupdate = 71; const char * SATTR_EVT_ontimeupdate = "timeupdate";
-constexpr short ATTR_EVT_ontoggle = 72; const char * SATTR_EVT_ontoggle = "toggle";
-constexpr short ATTR_EVT_onvolumechange = 73; const char * SATTR_EVT_onvolumechange = "volumechange";
-constexpr short ATTR_EVT_onwaiting = 74; const char * SATTR_EVT_onwaiting = "waiting";
-constexpr short ATTR_EVT_onwheel = 75; const char * SATTR_EVT_onwheel = "wheel";
+constexpr short ATTR_EVT_onafterprint = 0; constexpr const char * SATTR_EVT_onafterprint = "afterprint";
+constexpr short ATTR_EVT_onbeforeprint = 1; constexpr const char * SATTR_EVT_onbeforeprint = "beforeprint";
+constexpr short ATTR_EVT_oncanplay = 2; constexpr const char * SATTR_EVT_oncanplay = "canplay";
+constexpr short ATTR_EVT_oncanplaythrough = 3; constexpr const char * SATTR_EVT_oncanplaythrough = "canplaythrough";
+constexpr short ATTR_EVT_onchange = 4; constexpr const char * SATTR_EVT_onchange = "change";
+constexpr short ATTR_EVT_onclick = 5; constexpr const char * SATTR_EVT_onclick = "click";
+constexpr short ATTR_EVT_oncontextmenu = 6; constexpr const char * SATTR_EVT_oncontextmenu = "contextmenu";
+constexpr short ATTR_EVT_oncopy = 7; constexpr const char * SATTR_EVT_oncopy = "copy";
+constexpr short ATTR_EVT_oncuechange = 8; constexpr const char * SATTR_EVT_oncuechange = "cuechange";
+constexpr short ATTR_EVT_oncut = 9; constexpr const char * SATTR_EVT_oncut = "cut";
+constexpr short ATTR_EVT_ondblclick = 10; constexpr const char * SATTR_EVT_ondblclick = "dblclick";
+constexpr short ATTR_EVT_ondrag = 11; constexpr const char * SATTR_EVT_ondrag = "drag";
+constexpr short ATTR_EVT_ondragend = 12; constexpr const char * SATTR_EVT_ondragend = "dragend";
+constexpr short ATTR_EVT_ondragenter = 13; constexpr const char * SATTR_EVT_ondragenter = "dragenter";
+constexpr short ATTR_EVT_ondragleave = 14; constexpr const char * SATTR_EVT_ondragleave = "dragleave";
+constexpr short ATTR_EVT_ondragover = 15; constexpr const char * SATTR_EVT_ondragover = "dragover";
+constexpr short ATTR_EVT_ondragstart = 16; constexpr const char * SATTR_EVT_ondragstart = "dragstart";
+constexpr short ATTR_EVT_ondrop = 17; constexpr const char * SATTR_EVT_ondrop = "drop";
+constexpr short ATTR_EVT_ondurationchange = 18; constexpr const char * SATTR_EVT_ondurationchange = "durationchange";
+constexpr short ATTR_EVT_onemptied = 19; constexpr const char * SATTR_EVT_onemptied = "emptied";
+constexpr short ATTR_EVT_onended = 20; constexpr const char * SATTR_EVT_onended = "ended";
+constexpr short ATTR_EVT_onfocusin = 21; constexpr const char * SATTR_EVT_onfocusin = "focusin";
+constexpr short ATTR_EVT_onfocusout = 22; constexpr const char * SATTR_EVT_onfocusout = "focusout";
+constexpr short ATTR_EVT_onhashchange = 23; constexpr const char * SATTR_EVT_onhashchange = "hashchange";
+constexpr short ATTR_EVT_oninput = 24; constexpr const char * SATTR_EVT_oninput = "input";
+constexpr short ATTR_EVT_oninvalid = 25; constexpr const char * SATTR_EVT_oninvalid = "invalid";
+constexpr short ATTR_EVT_onkeydown = 26; constexpr const char * SATTR_EVT_onkeydown = "keydown";
+constexpr short ATTR_EVT_onkeypress = 27; constexpr const char * SATTR_EVT_onkeypress = "keypress";
+constexpr short ATTR_EVT_onkeyup = 28; constexpr const char * SATTR_EVT_onkeyup = "keyup";
+constexpr short ATTR_EVT_onloadeddata = 29; constexpr const char * SATTR_EVT_onloadeddata = "loadeddata";
+constexpr short ATTR_EVT_onloadedmetadata = 30; constexpr const char * SATTR_EVT_onloadedmetadata = "loadedmetadata";
+constexpr short ATTR_EVT_onloadstart = 31; constexpr const char * SATTR_EVT_onloadstart = "loadstart";
+constexpr short ATTR_EVT_onmousedown = 34; constexpr const char * SATTR_EVT_onmousedown = "mousedown";
+constexpr short ATTR_EVT_onmousemove = 35; constexpr const char * SATTR_EVT_onmousemove = "mousemove";
+constexpr short ATTR_EVT_onmouseout = 36; constexpr const char * SATTR_EVT_onmouseout = "mouseout";
+constexpr short ATTR_EVT_onmouseover = 37; constexpr const char * SATTR_EVT_onmouseover = "mouseover";
+constexpr short ATTR_EVT_onmouseup = 38; constexpr const char * SATTR_EVT_onmouseup = "mouseup";
+constexpr short ATTR_EVT_onmousewheel = 39; constexpr const char * SATTR_EVT_onmousewheel = "mousewheel";
+constexpr short ATTR_EVT_onoffline = 40; constexpr const char * SATTR_EVT_onoffline = "offline";
+constexpr short ATTR_EVT_ononline = 41; constexpr const char * SATTR_EVT_ononline = "online";
+constexpr short ATTR_EVT_onpagehide = 42; constexpr const char * SATTR_EVT_onpagehide = "pagehide";
+constexpr short ATTR_EVT_onpageshow = 43; constexpr const char * SATTR_EVT_onpageshow = "pageshow";
+constexpr short ATTR_EVT_onpaste = 44; constexpr const char * SATTR_EVT_onpaste = "paste";
+constexpr short ATTR_EVT_onpause = 45; constexpr const char * SATTR_EVT_onpause = "pause";
+constexpr short ATTR_EVT_onplay = 46; constexpr const char * SATTR_EVT_onplay = "play";
+constexpr short ATTR_EVT_onplaying = 47; constexpr const char * SATTR_EVT_onplaying = "playing";
+constexpr short ATTR_EVT_onpointerover = 48; constexpr const char * SATTR_EVT_onpointerover = "pointerover";
+constexpr short ATTR_EVT_onpointerdown = 50; constexpr const char * SATTR_EVT_onpointerdown = "pointerdown";
+constexpr short ATTR_EVT_onpointermove = 51; constexpr const char * SATTR_EVT_onpointermove = "pointermove";
+constexpr short ATTR_EVT_onpointerup = 52; constexpr const char * SATTR_EVT_onpointerup = "pointerup";
+constexpr short ATTR_EVT_onpointercancel = 53; constexpr const char * SATTR_EVT_onpointercancel = "pointercancel";
+constexpr short ATTR_EVT_onpointerout = 54; constexpr const char * SATTR_EVT_onpointerout = "pointerout";
+constexpr short ATTR_EVT_onpointerrawupdate = 56; constexpr const char * SATTR_EVT_onpointerrawupdate = "pointerrawupdate";
+constexpr short ATTR_EVT_onpopstate = 59; constexpr const char * SATTR_EVT_onpopstate = "popstate";
+constexpr short ATTR_EVT_onprogress = 60; constexpr const char * SATTR_EVT_onprogress = "progress";
+constexpr short ATTR_EVT_onratechange = 61; constexpr const char * SATTR_EVT_onratechange = "ratechange";
+constexpr short ATTR_EVT_onreset = 62; constexpr const char * SATTR_EVT_onreset = "reset";
+constexpr short ATTR_EVT_onsearch = 63; constexpr const char * SATTR_EVT_onsearch = "search";
+constexpr short ATTR_EVT_onseeked = 64; constexpr const char * SATTR_EVT_onseeked = "seeked";
+constexpr short ATTR_EVT_onseeking = 65; constexpr const char * SATTR_EVT_onseeking = "seeking";
+constexpr short ATTR_EVT_onselect = 66; constexpr const char * SATTR_EVT_onselect = "select";
+constexpr short ATTR_EVT_onstalled = 67; constexpr const char * SATTR_EVT_onstalled = "stalled";
+constexpr short ATTR_EVT_onstorage = 68; constexpr const char * SATTR_EVT_onstorage = "storage";
+constexpr short ATTR_EVT_onsubmit = 69; constexpr const char * SATTR_EVT_onsubmit = "submit";
+constexpr short ATTR_EVT_onsuspend = 70; constexpr const char * SATTR_EVT_onsuspend = "suspend";
+constexpr short ATTR_EVT_ontimeupdate = 71; constexpr const char * SATTR_EVT_ontimeupdate = "timeupdate";
+constexpr short ATTR_EVT_ontoggle = 72; constexpr const char * SATTR_EVT_ontoggle = "toggle";
+constexpr short ATTR_EVT_onvolumechange = 73; constexpr const char * SATTR_EVT_onvolumechange = "volumechange";
+constexpr short ATTR_EVT_onwaiting = 74; constexpr const char * SATTR_EVT_onwaiting = "waiting";
+constexpr short ATTR_EVT_onwheel = 75; constexpr const char * SATTR_EVT_onwheel = "wheel";
 
 // Non-Bubble Events (100-149)
 constexpr short ATTR_EVT_NON_BUBBLE_START = 100; 
 constexpr short ATTR_EVT_NON_BUBBLE_END = 200;
-constexpr short ATTR_EVT_onabort = 100; const char * SATTR_EVT_onabort = "abort";
-constexpr short ATTR_EVT_onbeforeunload = 101; const char * SATTR_EVT_onbeforeunload = "beforeunload";
-constexpr short ATTR_EVT_onblur = 102; const char * SATTR_EVT_onblur = "blur";
-constexpr short ATTR_EVT_onerror = 103; const char * SATTR_EVT_onerror = "error";
-constexpr short ATTR_EVT_onfocus = 104; const char * SATTR_EVT_onfocus = "focus";
-constexpr short ATTR_EVT_ongotpointercapture = 105; const char * SATTR_EVT_ongotpointercapture = "gotpointercapture";
-constexpr short ATTR_EVT_onload = 106; const char * SATTR_EVT_onload = "load";
-constexpr short ATTR_EVT_onlostpointercapture = 107; const char * SATTR_EVT_onlostpointercapture = "lostpointercapture";
-constexpr short ATTR_EVT_onmouseenter = 108; const char * SATTR_EVT_onmouseenter = "mouseenter";
-constexpr short ATTR_EVT_onmouseleave = 109; const char * SATTR_EVT_onmouseleave = "mouseleave";
-constexpr short ATTR_EVT_onpointerenter = 110; const char * SATTR_EVT_onpointerenter = "pointerenter";
-constexpr short ATTR_EVT_onpointerleave = 111; const char * SATTR_EVT_onpointerleave = "pointerleave";
-constexpr short ATTR_EVT_onresize = 112; const char * SATTR_EVT_onresize = "resize";
-constexpr short ATTR_EVT_onscroll = 113; const char * SATTR_EVT_onscroll = "scroll";
-constexpr short ATTR_EVT_onunload = 114; const char * SATTR_EVT_onunload = "unload";
+constexpr short ATTR_EVT_onabort = 100; constexpr const char * SATTR_EVT_onabort = "abort";
+constexpr short ATTR_EVT_onbeforeunload = 101; constexpr const char * SATTR_EVT_onbeforeunload = "beforeunload";
+constexpr short ATTR_EVT_onblur = 102; constexpr const char * SATTR_EVT_onblur = "blur";
+constexpr short ATTR_EVT_onerror = 103; constexpr const char * SATTR_EVT_onerror = "error";
+constexpr short ATTR_EVT_onfocus = 104; constexpr const char * SATTR_EVT_onfocus = "focus";
+constexpr short ATTR_EVT_ongotpointercapture = 105; constexpr const char * SATTR_EVT_ongotpointercapture = "gotpointercapture";
+constexpr short ATTR_EVT_onload = 106; constexpr const char * SATTR_EVT_onload = "load";
+constexpr short ATTR_EVT_onlostpointercapture = 107; constexpr const char * SATTR_EVT_onlostpointercapture = "lostpointercapture";
+constexpr short ATTR_EVT_onmouseenter = 108; constexpr const char * SATTR_EVT_onmouseenter = "mouseenter";
+constexpr short ATTR_EVT_onmouseleave = 109; constexpr const char * SATTR_EVT_onmouseleave = "mouseleave";
+constexpr short ATTR_EVT_onpointerenter = 110; constexpr const char * SATTR_EVT_onpointerenter = "pointerenter";
+constexpr short ATTR_EVT_onpointerleave = 111; constexpr const char * SATTR_EVT_onpointerleave = "pointerleave";
+constexpr short ATTR_EVT_onresize = 112; constexpr const char * SATTR_EVT_onresize = "resize";
+constexpr short ATTR_EVT_onscroll = 113; constexpr const char * SATTR_EVT_onscroll = "scroll";
+constexpr short ATTR_EVT_onunload = 114; constexpr const char * SATTR_EVT_onunload = "unload";
+
+// Non-bubble events volt.js dispatches from the container: capture-phase listeners for focus,
+// blur, scroll and pointer capture, enter/leave synthesized from mouseover/mouseout and
+// pointerover/pointerout. The others (load, error, abort, resize, unload, beforeunload) target
+// media or the window and keep a listener on the element. Keep in sync with DELEGATED_EVENTS in volt.js.
+constexpr bool isDelegatedEvent(short a_nEventId) {
+    switch (a_nEventId) {
+        case ATTR_EVT_onblur:
+        case ATTR_EVT_onfocus:
+        case ATTR_EVT_onscroll:
+        case ATTR_EVT_ongotpointercapture:
+        case ATTR_EVT_onlostpointercapture:
+        case ATTR_EVT_onmouseenter:
+        case ATTR_EVT_onmouseleave:
+        case ATTR_EVT_onpointerenter:
+        case ATTR_EVT_onpointerleave:
+            return true;
+        default:
+            return false;
+    }
+}
 
 // Volt: Special events (150-199)
 constexpr short ATTR_INTERNAL_CUSTOM_START = 150;
-constexpr short ATTR_EVT_onaddelement = 150;  const char * SATTR_EVT_onaddelement = "addelement";
-constexpr short ATTR_EVT_onbeforemoveelement = 151;  const char * SATTR_EVT_onbeforemoveelement = "beforemoveelement";
-constexpr short ATTR_EVT_onmoveelement = 152;  const char * SATTR_EVT_onmoveelement = "moveelement";
-constexpr short ATTR_EVT_onremoveelement = 153;  const char * SATTR_EVT_onremoveelement = "removeelement";
+constexpr short ATTR_EVT_onaddelement = 150;  constexpr const char * SATTR_EVT_onaddelement = "addelement";
+constexpr short ATTR_EVT_onbeforemoveelement = 151;  constexpr const char * SATTR_EVT_onbeforemoveelement = "beforemoveelement";
+constexpr short ATTR_EVT_onmoveelement = 152;  constexpr const char * SATTR_EVT_onmoveelement = "moveelement";
+constexpr short ATTR_EVT_onremoveelement = 153;  constexpr const char * SATTR_EVT_onremoveelement = "removeelement";
 constexpr short ATTR_INTERNAL_CUSTOM_END = 200; // non-inclusive
 
 // Common attributes (200-399)
@@ -230,6 +259,8 @@ constexpr short ATTR_viewbox = 311;
 constexpr short ATTR_width = 312;
 constexpr short ATTR_wrap = 313;
 constexpr short ATTR_xmlns = 314;
+constexpr short ATTR_scrolltop = 315;
+constexpr short ATTR_scrollleft = 316;
 // SGV
 constexpr short ATTR_by = 600;
 constexpr short ATTR_cx = 601;
@@ -329,6 +360,9 @@ constexpr short ATTR_zoomandpan = 693;
 // Volt: Special attributes
 constexpr short ATTR_nodevalue = 1000;
 constexpr short ATTR_key = 1001;
+constexpr short ATTR_styleprop = 1002; // One CSS declaration, see styleprop()
+constexpr short ATTR_classtoken = 1003; // One class token, see classtoken()
+constexpr short ATTR_animated = 1004; // Attribute or CSS property bound to a volt::Animated, see animate_style()
 
 // Custom attributes start at 20000
 constexpr short ATTR_CUSTOM_START = 20000;
@@ -336,7 +370,12 @@ constexpr short ATTR_CUSTOM_START = 20000;
 // ============================================================================
 // Attribute Name Lookup Table
 // ============================================================================
-inline const char* attrIdToName(short id) {
+
+// Ids below this have a name in the table, custom ids (ATTR_CUSTOM_START+) do not
+constexpr short ATTR_NAMED_END = ATTR_animated + 1; // non-inclusive
+
+// Only evaluated at compile time to fill g_attrNames, use attrIdToName() instead
+constexpr const char* attrNameOf(short id) {
     switch (id) {
         // Bubble Events
         case ATTR_EVT_onafterprint: return SATTR_EVT_onafterprint;
@@ -549,6 +588,8 @@ inline const char* attrIdToName(short id) {
         case ATTR_width: return "width";
         case ATTR_wrap: return "wrap";
         case ATTR_xmlns: return "xmlns";
+        case ATTR_scrolltop: return "scrollTop"; // Property only, see attrWriteOf()
+        case ATTR_scrollleft: return "scrollLeft"; // Property only, see attrWriteOf()
         // SGV
         case ATTR_by: return "by";
         case ATTR_cx: return "cx";
@@ -648,15 +689,106 @@ inline const char* attrIdToName(short id) {
         // Volt: Special attributes
         case ATTR_nodevalue: return "nodevalue"; // Special case for keeping text nodes's string content
         case ATTR_key: return "key"; // Special stable key attribute
+        case ATTR_styleprop: return "styleprop"; // Never written as an attribute
+        case ATTR_classtoken: return "classtoken"; // Never written as an attribute
+        case ATTR_animated: return "animated"; // Never written as an attribute
         
         default: return "unknown";
     }
 }
 
+// Attribute and event names indexed by id, O(1) lookup instead of the switch
+inline constexpr std::array<const char*, ATTR_NAMED_END> g_attrNames = [] {
+    std::array<const char*, ATTR_NAMED_END> names{};
+    for (short id = 0; id < ATTR_NAMED_END; ++id) {
+        names[id] = attrNameOf(id);
+    }
+    return names;
+}();
+
+inline const char* attrIdToName(short id) {
+    return (id >= 0 && id < ATTR_NAMED_END) ? g_attrNames[id] : "unknown";
+}
+
+// ============================================================================
+// Attribute Write Strategies
+// ============================================================================
+// How the DOM layer applies a prop. Properties are what carry the live state
+// of form controls (setAttribute("value") only changes the default value).
+
+enum class EAttrWrite : unsigned char {
+    ATTRIBUTE,       // setAttribute(name, value) / removeAttribute(name)
+    PROPERTY,        // element[prop] = value, skipped when the live value is already equal
+    NUMBER_PROPERTY, // element[prop] = Number(value), skipped when the live number is already equal, removal sets 0
+    BOOL_PROPERTY,   // element[prop] = (value != "false"), removal sets false
+    BOOL_ATTRIBUTE,  // toggleAttribute(name, value != "false"), presence is the value
+    STYLE,           // element.style.cssText = value
+};
+
+// Only evaluated at compile time to fill g_attrWrites, use attrWrite() instead
+constexpr EAttrWrite attrWriteOf(short id) {
+    switch (id) {
+        case ATTR_value:
+            return EAttrWrite::PROPERTY;
+
+        // class stays an attribute: className is a read-only SVGAnimatedString on SVG elements
+        case ATTR_scrolltop:
+        case ATTR_scrollleft:
+            return EAttrWrite::NUMBER_PROPERTY;
+
+        case ATTR_checked:
+        case ATTR_selected:
+        case ATTR_muted:
+            return EAttrWrite::BOOL_PROPERTY;
+
+        case ATTR_async:
+        case ATTR_autofocus:
+        case ATTR_autoplay:
+        case ATTR_controls:
+        case ATTR_defer:
+        case ATTR_disabled:
+        case ATTR_inert:
+        case ATTR_ismap:
+        case ATTR_loop:
+        case ATTR_multiple:
+        case ATTR_novalidate:
+        case ATTR_open:
+        case ATTR_readonly:
+        case ATTR_required:
+        case ATTR_reversed:
+            return EAttrWrite::BOOL_ATTRIBUTE;
+
+        case ATTR_style:
+            return EAttrWrite::STYLE;
+
+        default:
+            return EAttrWrite::ATTRIBUTE;
+    }
+}
+
+// Property name for PROPERTY/NUMBER_PROPERTY/BOOL_PROPERTY writes. All of them match
+// the attribute name so far, a property spelled differently gets its case here.
+constexpr const char* attrPropertyNameOf(short id) {
+    return attrNameOf(id);
+}
+
+inline constexpr std::array<EAttrWrite, ATTR_NAMED_END> g_attrWrites = [] {
+    std::array<EAttrWrite, ATTR_NAMED_END> writes{};
+    for (short id = 0; id < ATTR_NAMED_END; ++id) {
+        writes[id] = attrWriteOf(id);
+    }
+    return writes;
+}();
+
+inline EAttrWrite attrWrite(short id) {
+    return (id >= 0 && id < ATTR_NAMED_END) ? g_attrWrites[id] : EAttrWrite::ATTRIBUTE;
+}
+
 // ============================================================================
 // Common Attributes
 // ============================================================================
 
+// A volt::String value stays in JS, see String.hpp. Templates, so literals still pick std::string.
 #define DEFINE_ATTR_HELPER(funcAttrName) \
     inline std::pair<short, std::string> funcAttrName(std::string a_sValue) { \
         return {ATTR_##funcAttrName, a_sValue}; \
@@ -666,6 +798,14 @@ inline const char* attrIdToName(short id) {
             return {ATTR_undefined, ""}; \
         } \
         return {ATTR_##funcAttrName, a_sValue}; \
+    } \
+    template<typename TString> requires std::is_same_v<std::remove_cvref_t<TString>, String> \
+    inline std::pair<short, String> funcAttrName(TString&& a_sValue) { \
+        return {ATTR_##funcAttrName, std::forward<TString>(a_sValue)}; \
+    } \
+    template<typename TString> requires std::is_same_v<std::remove_cvref_t<TString>, String> \
+    inline std::pair<short, String> funcAttrName##_if(bool a_bCondition, TString&& a_sValue) { \
+        return {a_bCondition ? ATTR_##funcAttrName : ATTR_undefined, std::forward<TString>(a_sValue)}; \
     }
 
 DEFINE_ATTR_HELPER(accept)
@@ -783,6 +923,8 @@ DEFINE_ATTR_HELPER(viewbox)
 DEFINE_ATTR_HELPER(width)
 DEFINE_ATTR_HELPER(wrap)
 DEFINE_ATTR_HELPER(xmlns)
+DEFINE_ATTR_HELPER(scrolltop)
+DEFINE_ATTR_HELPER(scrollleft)
 // SGV
 DEFINE_ATTR_HELPER(by)
 DEFINE_ATTR_HELPER(cx)
@@ -882,19 +1024,117 @@ DEFINE_ATTR_HELPER(zoomandpan)
 // Volt: Special Attributes
 DEFINE_ATTR_HELPER(key)
 
+// ============================================================================
+// Structured Style and Class
+// ============================================================================
+// Diffed per CSS property / class token and applied with style.setProperty()
+// and classList, so changing one property does not rewrite the whole attribute.
+// They can be combined with style() / classname() on the same element: when
+// the attribute is rewritten, the properties and tokens are applied again.
+
+// Text of a CSS declaration or class token. A string literal is kept by pointer:
+// nothing is copied per render and the diff of an unchanged literal is a pointer
+// compare. Anything else is an owned copy. The literal constructor is consteval
+// (see FormatLiteral), a char buffer must be passed as std::string.
+class SharedText {
+public:
+    SharedText() = default;
+    consteval SharedText(const char* a_sLiteral) : m_sLiteral(a_sLiteral) {}
+    SharedText(std::string a_sText) : m_sOwned(std::move(a_sText)) {}
+
+    std::string_view view() const { return m_sOwned ? std::string_view(*m_sOwned) : m_sLiteral; }
+    bool empty() const { return view().empty(); }
+
+    bool operator==(const SharedText& a_other) const {
+        return isSameLiteral(a_other) || view() == a_other.view();
+    }
+    int compare(const SharedText& a_other) const {
+        return isSameLiteral(a_other) ? 0 : view().compare(a_other.view());
+    }
+
+private:
+    bool isSameLiteral(const SharedText& a_other) const {
+        return m_sLiteral.data() != nullptr && m_sLiteral.data() == a_other.m_sLiteral.data();
+    }
+
+    std::string_view m_sLiteral;
+    std::optional<std::string> m_sOwned; // Disengaged for a literal, so the consteval constructor stays a constant expression
+};
+
+// One CSS declaration, e.g. {"width", "40%"}
+struct StyleProp {
+    SharedText property;
+    SharedText value;
+};
+
+inline std::pair<short, StyleProp> styleprop(SharedText a_sProperty, SharedText a_sValue) {
+    return {ATTR_styleprop, {std::move(a_sProperty), std::move(a_sValue)}};
+}
+inline std::pair<short, StyleProp> styleprop_if(bool a_bCondition, SharedText a_sProperty, SharedText a_sValue) {
+    if (!a_bCondition) {
+        return {ATTR_undefined, {}};
+    }
+    return {ATTR_styleprop, {std::move(a_sProperty), std::move(a_sValue)}};
+}
+
+inline std::pair<short, SharedText> classtoken(SharedText a_sToken) {
+    return {ATTR_classtoken, std::move(a_sToken)};
+}
+inline std::pair<short, SharedText> classtoken_if(bool a_bCondition, SharedText a_sToken) {
+    return {a_bCondition ? ATTR_classtoken : ATTR_undefined, std::move(a_sToken)};
+}
+template<typename TString> requires std::is_same_v<std::remove_cvref_t<TString>, String>
+inline std::pair<short, String> classtoken(TString&& a_sToken) {
+    return {ATTR_classtoken, std::forward<TString>(a_sToken)};
+}
+template<typename TString> requires std::is_same_v<std::remove_cvref_t<TString>, String>
+inline std::pair<short, String> classtoken_if(bool a_bCondition, TString&& a_sToken) {
+    return {a_bCondition ? ATTR_classtoken : ATTR_undefined, std::forward<TString>(a_sToken)};
+}
+
+// ============================================================================
+// Animated Bindings
+// ============================================================================
+// Binds a CSS property or an attribute to a volt::Animated. Each animation
+// frame writes the interpolated value to that one property, without a render,
+// the rest of the element is diffed as usual. Don't also set the same
+// property with styleprop() or the attribute helper.
+
+// Written as prefix + value + suffix, e.g. {"transform", &x, "translateX(", "px)"}
+struct AnimatedProp {
+    AnimatedBase* pAnimated = nullptr; // Reset by ~AnimatedBase on the nodes bound to it
+    short nAttrId = ATTR_undefined; // ATTR_styleprop for a CSS property
+    std::string property;           // CSS property, ATTR_styleprop only
+    std::string prefix;
+    std::string suffix;
+};
+
+inline std::pair<short, AnimatedProp> animate_style(std::string a_sProperty, AnimatedBase& a_animated, std::string a_sUnit = "") {
+    return {ATTR_animated, {&a_animated, ATTR_styleprop, std::move(a_sProperty), "", std::move(a_sUnit)}};
+}
+inline std::pair<short, AnimatedProp> animate_style(std::string a_sProperty, AnimatedBase& a_animated, std::string a_sPrefix, std::string a_sSuffix) {
+    return {ATTR_animated, {&a_animated, ATTR_styleprop, std::move(a_sProperty), std::move(a_sPrefix), std::move(a_sSuffix)}};
+}
+inline std::pair<short, AnimatedProp> animate_attr(short a_nAttrId, AnimatedBase& a_animated, std::string a_sUnit = "") {
+    return {ATTR_animated, {&a_animated, a_nAttrId, "", "", std::move(a_sUnit)}};
+}
+
 // ============================================================================
 // Events 
 // ============================================================================
 
+// The callback is stored in place, see InplaceFunction.hpp for the capture budget
 #define DECLARE_EVENT_HELPER(funcEvtName) \
-    inline std::pair<short, std::function<void(emscripten::val)>> funcEvtName(std::function<void(emscripten::val)> a_fnCallback) { \
-        return {ATTR_EVT_##funcEvtName, a_fnCallback}; \
+    template<typename Callback> \
+    inline std::pair<short, EventHandler> funcEvtName(Callback&& a_fnCallback) { \
+        return {ATTR_EVT_##funcEvtName, EventHandler(std::forward<Callback>(a_fnCallback))}; \
     } \
-    inline std::pair<short, std::function<void(emscripten::val)>> funcEvtName##_if(bool a_bCondition, std::function<void(emscripten::val)> a_fnCallback) { \
+    template<typename Callback> \
+    inline std::pair<short, EventHandler> funcEvtName##_if(bool a_bCondition, Callback&& a_fnCallback) { \
         if (!a_bCondition) { \
-            return {ATTR_undefined, [](auto){}}; \
+            return {ATTR_undefined, EventHandler()}; \
         } \
-        return {ATTR_EVT_##funcEvtName, a_fnCallback}; \
+        return {ATTR_EVT_##funcEvtName, EventHandler(std::forward<Callback>(a_fnCallback))}; \
     }
 
 // Bubble Events
@@ -5,20 +5,76 @@
 // ============================================================================
 
 #include <emscripten/val.h>
+#include <string>
+#include <string_view>
+#include "ETags.hpp"
+#include "InplaceFunction.hpp"
 
 namespace volt {
 
 namespace dom {
 
+// Batched commit (VOLT_ENABLE_PATCH_BUFFER): between beginPatch() and commitPatch() the
+// writes below are recorded into one serialized patch and applied by a single JS call.
+// Without the flag they are no-ops and every write goes straight to the DOM.
+void beginPatch();
+
+void commitPatch();
+
+// Runs after the pending patch is applied, or right away when nothing is being recorded
+void afterCommit(InplaceFunction<void()> a_fn);
+
+// JS strings for attribute/event and tag names, created on first use and kept
+// for the session: names cross the wasm boundary once, not on every DOM call.
+const emscripten::val& attrName(short a_nAttrId);
+
+const emscripten::val& tagName(tag::ETag a_nTag);
+
+const emscripten::val& propertyName(short a_nAttrId);
+
+// Id based writes follow attr::attrWrite(): attribute, property, boolean or style
+void setAttribute(emscripten::val a_element, short a_nAttrId, const std::string& a_sValue);
+
+// volt::String values, the JS string is passed on by handle
+void setAttribute(emscripten::val a_element, short a_nAttrId, const emscripten::val& a_hValue);
+
+void removeAttribute(emscripten::val a_element, short a_nAttrId);
+
+void addEventListener(emscripten::val a_element, short a_nEventId, emscripten::val a_handler);
+
+void removeEventListener(emscripten::val a_element, short a_nEventId, emscripten::val a_handler);
+
+emscripten::val createElement(tag::ETag a_nTag);
+
+// Structured style/class writes, take the element's `style` / `classList` object
+void setStyleProperty(emscripten::val a_hStyle, std::string_view a_sProperty, std::string_view a_sValue);
+
+void removeStyleProperty(emscripten::val a_hStyle, std::string_view a_sProperty);
+
+void addClass(emscripten::val a_hClassList, std::string_view a_sToken);
+
+void removeClass(emscripten::val a_hClassList, std::string_view a_sToken);
+
 void setAttribute(emscripten::val a_element, std::string a_sKey, std::string a_sValue);
 
 void setAttribute(emscripten::val a_element, std::string a_sKey, emscripten::val a_value);
 
 void removeAttribute(emscripten::val a_element, std::string a_sKey);
 
+void addEventListener(emscripten::val a_element, std::string a_sEventName, emscripten::val a_handler);
+
+void removeEventListener(emscripten::val a_element, std::string a_sEventName, emscripten::val a_handler);
+
+// Text goes to JS straight from the UTF-8 bytes, no std::string copy on the way
+void setNodeValue(emscripten::val a_textNode, std::string_view a_sText);
+
 emscripten::val createElement(std::string a_sTagName);
 
-emscripten::val createTextNode(std::string a_sText);
+emscripten::val createTextNode(std::string_view a_sText);
+
+void setNodeValue(emscripten::val a_textNode, const emscripten::val& a_hText);
+
+emscripten::val createTextNode(const emscripten::val& a_hText);
 
 emscripten::val getElementById(std::string a_sId);
 
@@ -1,30 +1,296 @@
 #include "DOM.hpp"
+#include "VoltProfiler.hpp"
+#include "VoltPatch.hpp"
+#include <vector>
+#include <cstdlib>
+#include <emscripten.h>
+
+// JS string from UTF-8 bytes, embind would copy a std::string into a temporary buffer first
+EM_JS(EM_VAL, volt_js_utf8_string, (const char* a_pBytes, size_t a_nLength), {
+    return Emval.toHandle(UTF8ToString(Number(a_pBytes), Number(a_nLength)));
+});
 
 namespace volt {
 
 namespace dom {
 
+static emscripten::val jsString(std::string_view a_sText) {
+    return emscripten::val::take_ownership(volt_js_utf8_string(a_sText.data(), a_sText.size()));
+}
+
+#ifdef VOLT_ENABLE_PATCH_BUFFER
+
+    // Patch being recorded, set between beginPatch() and commitPatch()
+    inline thread_local PatchBuffer* g_pPatchBuffer = nullptr;
+
+    #define VOLT_PATCH_RECORD(call) \
+        do { if (g_pPatchBuffer != nullptr) { g_pPatchBuffer->call; return; } } while (0)
+
+#else
+
+    #define VOLT_PATCH_RECORD(call) do {} while (0)
+
+#endif
+
+void beginPatch() {
+#ifdef VOLT_ENABLE_PATCH_BUFFER
+    thread_local PatchBuffer s_patchBuffer;
+    g_pPatchBuffer = &s_patchBuffer;
+#endif
+}
+
+void commitPatch() {
+#ifdef VOLT_ENABLE_PATCH_BUFFER
+    PatchBuffer* pPatchBuffer = g_pPatchBuffer;
+    g_pPatchBuffer = nullptr;
+    if (pPatchBuffer != nullptr) {
+        pPatchBuffer->flush();
+    }
+#endif
+}
+
+void afterCommit(InplaceFunction<void()> a_fn) {
+#ifdef VOLT_ENABLE_PATCH_BUFFER
+    if (g_pPatchBuffer != nullptr) {
+        g_pPatchBuffer->afterCommit(std::move(a_fn));
+        return;
+    }
+#endif
+    a_fn();
+}
+
+const emscripten::val& attrName(short a_nAttrId) {
+    // Last slot holds "unknown", shared by all ids without a name
+    thread_local std::vector<emscripten::val> s_names(attr::ATTR_NAMED_END + 1, emscripten::val::undefined());
+
+    size_t nIdx = (a_nAttrId >= 0 && a_nAttrId < attr::ATTR_NAMED_END) ? a_nAttrId : attr::ATTR_NAMED_END;
+    if (s_names[nIdx].isUndefined()) {
+        s_names[nIdx] = emscripten::val(attr::attrIdToName(a_nAttrId));
+    }
+    return s_names[nIdx];
+}
+
+const emscripten::val& tagName(tag::ETag a_nTag) {
+    thread_local std::vector<emscripten::val> s_names(static_cast<size_t>(tag::ETag::_COUNT), emscripten::val::undefined());
+
+    size_t nIdx = static_cast<size_t>(a_nTag);
+    if (nIdx >= s_names.size()) {
+        nIdx = static_cast<size_t>(tag::ETag::div); // Same fallback as tagToString()
+    }
+    if (s_names[nIdx].isUndefined()) {
+        s_names[nIdx] = emscripten::val(tag::tagToString(static_cast<tag::ETag>(nIdx)));
+    }
+    return s_names[nIdx];
+}
+
+const emscripten::val& propertyName(short a_nAttrId) {
+    thread_local std::vector<emscripten::val> s_names(attr::ATTR_NAMED_END + 1, emscripten::val::undefined());
+
+    size_t nIdx = (a_nAttrId >= 0 && a_nAttrId < attr::ATTR_NAMED_END) ? a_nAttrId : attr::ATTR_NAMED_END;
+    if (s_names[nIdx].isUndefined()) {
+        s_names[nIdx] = emscripten::val(attr::attrPropertyNameOf(a_nAttrId));
+    }
+    return s_names[nIdx];
+}
+
+void setAttribute(emscripten::val a_element, short a_nAttrId, const std::string& a_sValue) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PATCH_RECORD(setAttribute(a_element, a_nAttrId, a_sValue));
+
+    switch (attr::attrWrite(a_nAttrId)) {
+        case attr::EAttrWrite::PROPERTY: {
+            const emscripten::val& hName = propertyName(a_nAttrId);
+            emscripten::val hValue(a_sValue);
+            if (a_element[hName].strictlyEquals(hValue)) {
+                return; // Live value already matches, e.g. controlled input after a keystroke
+            }
+            a_element.set(hName, hValue);
+            break;
+        }
+        case attr::EAttrWrite::NUMBER_PROPERTY: {
+            // The live value is a number, a string compare would never match
+            const emscripten::val& hName = propertyName(a_nAttrId);
+            double fValue = std::strtod(a_sValue.c_str(), nullptr);
+            if (a_element[hName].as<double>() == fValue) {
+                return;
+            }
+            a_element.set(hName, fValue);
+            break;
+        }
+        case attr::EAttrWrite::BOOL_PROPERTY:
+            a_element.set(propertyName(a_nAttrId), a_sValue != "false");
+            break;
+        case attr::EAttrWrite::BOOL_ATTRIBUTE:
+            a_element.call<void>("toggleAttribute", attrName(a_nAttrId), a_sValue != "false");
+            break;
+        case attr::EAttrWrite::STYLE:
+            a_element["style"].set("cssText", a_sValue);
+            break;
+        default:
+            a_element.call<void>("setAttribute", attrName(a_nAttrId), a_sValue);
+            break;
+    }
+
+    VOLT_PROFILE_COUNT(attrsSet);
+}
+
+void setAttribute(emscripten::val a_element, short a_nAttrId, const emscripten::val& a_hValue) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PATCH_RECORD(setAttribute(a_element, a_nAttrId, a_hValue));
+
+    switch (attr::attrWrite(a_nAttrId)) {
+        case attr::EAttrWrite::PROPERTY: {
+            const emscripten::val& hName = propertyName(a_nAttrId);
+            if (a_element[hName].strictlyEquals(a_hValue)) {
+                return;
+            }
+            a_element.set(hName, a_hValue);
+            break;
+        }
+        case attr::EAttrWrite::NUMBER_PROPERTY:
+        case attr::EAttrWrite::BOOL_PROPERTY:
+        case attr::EAttrWrite::BOOL_ATTRIBUTE:
+            setAttribute(a_element, a_nAttrId, a_hValue.as<std::string>()); // A number or "false", no need to keep it in JS
+            return;
+        case attr::EAttrWrite::STYLE:
+            a_element["style"].set("cssText", a_hValue);
+            break;
+        default:
+            a_element.call<void>("setAttribute", attrName(a_nAttrId), a_hValue);
+            break;
+    }
+
+    VOLT_PROFILE_COUNT(attrsSet);
+}
+
+void removeAttribute(emscripten::val a_element, short a_nAttrId) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PROFILE_COUNT(attrsRemoved);
+    VOLT_PATCH_RECORD(removeAttribute(a_element, a_nAttrId));
+
+    switch (attr::attrWrite(a_nAttrId)) {
+        case attr::EAttrWrite::PROPERTY:
+            a_element.set(propertyName(a_nAttrId), std::string());
+            break;
+        case attr::EAttrWrite::NUMBER_PROPERTY:
+            a_element.set(propertyName(a_nAttrId), 0);
+            break;
+        case attr::EAttrWrite::BOOL_PROPERTY:
+            a_element.set(propertyName(a_nAttrId), false);
+            break;
+        default:
+            a_element.call<void>("removeAttribute", attrName(a_nAttrId));
+            break;
+    }
+}
+
+void addEventListener(emscripten::val a_element, short a_nEventId, emscripten::val a_handler) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PROFILE_COUNT(listenersAdded);
+    VOLT_PATCH_RECORD(addEventListener(a_element, a_nEventId, a_handler));
+    a_element.call<void>("addEventListener", attrName(a_nEventId), a_handler);
+}
+
+void removeEventListener(emscripten::val a_element, short a_nEventId, emscripten::val a_handler) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PROFILE_COUNT(listenersRemoved);
+    VOLT_PATCH_RECORD(removeEventListener(a_element, a_nEventId, a_handler));
+    a_element.call<void>("removeEventListener", attrName(a_nEventId), a_handler);
+}
+
+emscripten::val createElement(tag::ETag a_nTag) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    return emscripten::val::global("document").call<emscripten::val>("createElement", tagName(a_nTag));
+}
+
+void setStyleProperty(emscripten::val a_hStyle, std::string_view a_sProperty, std::string_view a_sValue) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PROFILE_COUNT(attrsSet);
+    VOLT_PATCH_RECORD(setStyleProperty(a_hStyle, a_sProperty, a_sValue));
+    a_hStyle.call<void>("setProperty", jsString(a_sProperty), jsString(a_sValue));
+}
+
+void removeStyleProperty(emscripten::val a_hStyle, std::string_view a_sProperty) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PROFILE_COUNT(attrsRemoved);
+    VOLT_PATCH_RECORD(removeStyleProperty(a_hStyle, a_sProperty));
+    a_hStyle.call<void>("removeProperty", jsString(a_sProperty));
+}
+
+void addClass(emscripten::val a_hClassList, std::string_view a_sToken) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PROFILE_COUNT(attrsSet);
+    VOLT_PATCH_RECORD(addClass(a_hClassList, a_sToken));
+    a_hClassList.call<void>("add", jsString(a_sToken));
+}
+
+void removeClass(emscripten::val a_hClassList, std::string_view a_sToken) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PROFILE_COUNT(attrsRemoved);
+    VOLT_PATCH_RECORD(removeClass(a_hClassList, a_sToken));
+    a_hClassList.call<void>("remove", jsString(a_sToken));
+}
+
 void setAttribute(emscripten::val a_element, std::string a_sKey, std::string a_sValue) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PROFILE_COUNT(attrsSet);
     //a_element.set(a_sKey, a_sValue);
     a_element.call<void>("setAttribute", a_sKey, a_sValue);
 }
 
 void setAttribute(emscripten::val a_element, std::string a_sKey, emscripten::val a_value) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PROFILE_COUNT(attrsSet);
     //a_element.set(a_sKey, a_value);
     a_element.call<void>("setAttribute", a_sKey, a_value);
 }
 
 void removeAttribute(emscripten::val a_element, std::string a_sKey) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PROFILE_COUNT(attrsRemoved);
     //a_element.delete_(a_sKey);
     a_element.call<void>("removeAttribute", a_sKey);
 }
 
+void addEventListener(emscripten::val a_element, std::string a_sEventName, emscripten::val a_handler) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PROFILE_COUNT(listenersAdded);
+    a_element.call<void>("addEventListener", a_sEventName, a_handler);
+}
+
+void removeEventListener(emscripten::val a_element, std::string a_sEventName, emscripten::val a_handler) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PROFILE_COUNT(listenersRemoved);
+    a_element.call<void>("removeEventListener", a_sEventName, a_handler);
+}
+
+void setNodeValue(emscripten::val a_textNode, std::string_view a_sText) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PROFILE_COUNT(textsUpdated);
+    VOLT_PATCH_RECORD(setNodeValue(a_textNode, a_sText));
+    a_textNode.set("nodeValue", jsString(a_sText));
+}
+
 emscripten::val createElement(std::string a_sTagName) {
+    VOLT_PROFILE_SCOPE(commitMs);
     return emscripten::val::global("document").call<emscripten::val>("createElement", a_sTagName);
 }
 
-emscripten::val createTextNode(std::string a_sText) {
-    return emscripten::val::global("document").call<emscripten::val>("createTextNode", a_sText);
+emscripten::val createTextNode(std::string_view a_sText) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    return emscripten::val::global("document").call<emscripten::val>("createTextNode", jsString(a_sText));
+}
+
+void setNodeValue(emscripten::val a_textNode, const emscripten::val& a_hText) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PROFILE_COUNT(textsUpdated);
+    VOLT_PATCH_RECORD(setNodeValue(a_textNode, a_hText));
+    a_textNode.set("nodeValue", a_hText);
+}
+
+emscripten::val createTextNode(const emscripten::val& a_hText) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    return emscripten::val::global("document").call<emscripten::val>("createTextNode", a_hText);
 }
 
 emscripten::val getElementById(std::string a_sId) {
@@ -32,27 +298,34 @@ emscripten::val getElementById(std::string a_sId) {
 }
 
 void insertBefore(emscripten::val a_parent, emscripten::val a_newChild, emscripten::val a_referenceNode) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PATCH_RECORD(insertBefore(a_parent, a_newChild, a_referenceNode));
     a_parent.call<void>("insertBefore", a_newChild, a_referenceNode);
 }
 
 void appendChild(emscripten::val a_parent, emscripten::val a_child) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PATCH_RECORD(appendChild(a_parent, a_child));
     a_parent.call<void>("appendChild", a_child);
 }
 
 void removeChild(emscripten::val a_parent, emscripten::val a_child) {
+    VOLT_PROFILE_SCOPE(commitMs);
+    VOLT_PATCH_RECORD(removeChild(a_parent, a_child));
     a_parent.call<void>("removeChild", a_child);
 }
 
 void replaceChild(emscripten::val a_parent, emscripten::val a_newChild, emscripten::val a_oldChild) {
+    VOLT_PROFILE_SCOPE(commitMs);
     a_parent.call<void>("replaceChild", a_newChild, a_oldChild);
 }
 
 emscripten::val getChildAt(emscripten::val a_parent, int a_nIndex) {
-    return a_parent.call<emscripten::val>("getChildAt", a_nIndex);
+    return a_parent["childNodes"][a_nIndex];
 }
 
 int getChildCount(emscripten::val a_parent) {
-    return a_parent.call<int>("getChildCount");
+    return a_parent["childNodes"]["length"].as<int>();
 }
 
 } // namespace dom
@@ -198,8 +198,10 @@ enum class ETag {
     textpath,
     tspan,
     use,
-    view
+    view,
     // Add more as needed
+
+    _COUNT       // Number of tags, keep last
 };
 
 } // namespace tag
@@ -1,10 +1,25 @@
 #pragma once
 #include <emscripten.h>
+#include <string_view>
 
 namespace volt {
 
-void invokeBubbleEvent(emscripten::val event);
+// Discrete input (key, click, input, focus...) renders before control returns to the browser,
+// continuous input (move, scroll, wheel...) waits for the animation frame
+bool isDiscreteEvent(std::string_view a_sEventType);
 
+// Returns true when a discrete event invalidated an engine: volt.js then calls flushVoltSync()
+// once, after the handlers of every ancestor ran
+bool invokeBubbleEvent(emscripten::val event);
+
+// Flushes itself, a non-bubble event has a single handler
 void invokeNonBubbleEvent(emscripten::val event);
 
+// Renders and patches every invalidated engine now, instead of in the next animation frame.
+// Does nothing inside a render, the pending frame renders then.
+void flushSync();
+
+// Resumes the tasks of a lane (ETaskLane), bound as Module.runVoltTasks by the app
+void runScheduledTasks(int a_nLane, double a_nBudgetMs);
+
 } // namespace volt
\ No newline at end of file
@@ -1,23 +1,38 @@
 #include "EventBridge.hpp"
+#include <algorithm>
 
 namespace volt {
 
-void invokeBubbleEvent(emscripten::val event) {
-    if (!event.hasOwnProperty("__volt_cpp_ptr")) {
-        EM_ASM({ console.warn("invokeBubbleEvent: missing __volt_cpp_ptr"); });
-        return;
-    }
+bool isDiscreteEvent(std::string_view a_sEventType) {
+    static constexpr std::string_view s_discreteEvents[] = {
+        "beforeinput", "blur", "change", "click", "compositionend", "compositionstart", "contextmenu",
+        "copy", "cut", "dblclick", "dragend", "dragstart", "drop", "focus", "focusin", "focusout",
+        "input", "keydown", "keypress", "keyup", "mousedown", "mouseup", "paste", "pointerdown",
+        "pointerup", "reset", "select", "submit", "toggle", "touchend", "touchstart",
+    };
+    return std::binary_search(std::begin(s_discreteEvents), std::end(s_discreteEvents), a_sEventType);
+}
 
-    intptr_t cpp_ptr_as_int = event["__volt_cpp_ptr"].as<intptr_t>();
-    if (cpp_ptr_as_int == 0) {
-        return;
+bool invokeBubbleEvent(emscripten::val event) {
+    if (!event.hasOwnProperty("__volt_node")) {
+        EM_ASM({ console.warn("invokeBubbleEvent: missing __volt_node"); });
+        return false;
     }
 
-    auto* pVNode = reinterpret_cast<volt::VNode*>(cpp_ptr_as_int);
+    // Stale when the element's VNode was recycled, e.g. an event queued behind a removal
+    VNode* pVNode = VNodeTable::instance().find(event["__volt_node"].as<VNodeId>());
+    if (pVNode == nullptr) {
+        return false;
+    }
 
     std::string sEventType = event["type"].as<std::string>();
 
-    (void)pVNode->bubbleCallback(sEventType, event);
+    // Handlers don't carry their engine, it is invalidated here at dispatch time
+    if (pVNode->bubbleCallback(sEventType, event) && pVNode->getEngine() != nullptr) {
+        pVNode->getEngine()->invalidate();
+        return isDiscreteEvent(sEventType);
+    }
+    return false;
 }
 
 void invokeNonBubbleEvent(emscripten::val event) {
@@ -27,21 +42,35 @@ void invokeNonBubbleEvent(emscripten::val event) {
         return;
     }
 
-    if (!target.hasOwnProperty("__cpp_ptr")) {
-        EM_ASM({ console.warn("Non-bubble event target has no __cpp_ptr"); });
+    if (!target.hasOwnProperty("__volt_node")) {
+        EM_ASM({ console.warn("Non-bubble event target has no __volt_node"); });
         return;
     }
 
-    intptr_t cpp_ptr_as_int = target["__cpp_ptr"].as<intptr_t>();
-    if (cpp_ptr_as_int == 0) {
+    VNode* pVNode = VNodeTable::instance().find(target["__volt_node"].as<VNodeId>());
+    if (pVNode == nullptr) {
         return;
     }
 
-    auto* pVNode = reinterpret_cast<volt::VNode*>(cpp_ptr_as_int);
-
     std::string sEventType = event["type"].as<std::string>();
 
-    (void)pVNode->nonBubbleCallback(sEventType, event);
+    if (pVNode->nonBubbleCallback(sEventType, event) && pVNode->getEngine() != nullptr) {
+        pVNode->getEngine()->invalidate();
+        if (isDiscreteEvent(sEventType)) {
+            flushSync();
+        }
+    }
+}
+
+void flushSync() {
+    VoltScheduler::instance().flushSync();
+}
+
+void runScheduledTasks(int a_nLane, double a_nBudgetMs) {
+    if (a_nLane < 0 || a_nLane > static_cast<int>(ETaskLane::IDLE)) {
+        return;
+    }
+    VoltScheduler::instance().runTasks(static_cast<ETaskLane>(a_nLane), a_nBudgetMs);
 }
 
 } // namespace volt
\ No newline at end of file
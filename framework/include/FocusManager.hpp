@@ -1,36 +1,41 @@
 #pragma once
 
-#include <unordered_set>
-#include <emscripten/val.h>
+#include "VNodeTable.hpp"
 
 namespace volt {
 
-struct ValHash {
-    std::size_t operator()(const emscripten::val& v) const noexcept {
-        return std::hash<uintptr_t>{}(reinterpret_cast<uintptr_t>(v.as_handle())); 
-    }
-};
+class VNode;
+
+// ============================================================================
+// FocusManager - The focused element of an engine, as a flagged VNode chain
+// ============================================================================
+// volt.js reports a focus change in one call with the focused element's
+// __volt_node. The VNode and its ancestors are flagged (VNode::hasFocusWithin),
+// so walk() tests a flag instead of looking elements up. The chain moves to
+// the new VTree after every diff.
 
 class FocusManager {
 public:
     FocusManager() {}
     ~FocusManager() = default;
 
-    bool isFocused(emscripten::val a_hElement) {
-        return m_focusedElements.count(a_hElement) != 0;
-    }
+    // Focus moved to the element of a_nTarget, 0 when it left the engine
+    void        focus                       (VNodeId a_nTarget);
+    void        clear                       () { focus(0); }
 
-    void clear() {
-        m_focusedElements.clear();
-    }
+    // The focused element was handed from a_pOldNode to a_pNewNode, called by syncNodes()
+    void        transfer                    (const VNode* a_pOldNode, const VNode* a_pNewNode);
 
-    void add(emscripten::val a_hElement) {
-        m_focusedElements.insert(a_hElement);
-    }
+    // Flags the chain in the VTree just diffed, the old tree's flags go with its VNodes
+    void        onDiffDone                  ();
+
+    VNodeId     getTarget                   () const { return m_nTarget; }
 
 private:
+    static void markChain                   (VNode* a_pNode, bool a_bFocused);
+
     // MEMBERS
-    std::unordered_set<emscripten::val, ValHash> m_focusedElements;
+    VNodeId     m_nTarget = 0; // VNode of the focused element, stale once its element is gone
 };
 
-} // namespace volt
\ No newline at end of file
+} // namespace volt
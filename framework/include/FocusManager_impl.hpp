@@ -0,0 +1,32 @@
+#include "FocusManager.hpp"
+#include "VNode.hpp"
+
+namespace volt {
+
+// ============================================================================
+// FocusManager
+// ============================================================================
+
+void FocusManager::focus(VNodeId a_nTarget) {
+    markChain(VNodeTable::instance().find(m_nTarget), false);
+    m_nTarget = a_nTarget;
+    markChain(VNodeTable::instance().find(m_nTarget), true);
+}
+
+void FocusManager::transfer(const VNode* a_pOldNode, const VNode* a_pNewNode) {
+    if (m_nTarget != 0 && a_pOldNode->getNodeId() == m_nTarget) {
+        m_nTarget = a_pNewNode->getNodeId();
+    }
+}
+
+void FocusManager::onDiffDone() {
+    markChain(VNodeTable::instance().find(m_nTarget), true);
+}
+
+void FocusManager::markChain(VNode* a_pNode, bool a_bFocused) {
+    for (; a_pNode != nullptr; a_pNode = a_pNode->getParent()) {
+        a_pNode->setFocusWithin(a_bFocused);
+    }
+}
+
+} // namespace volt
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "VoltTask.hpp"
+
 namespace volt {
 
 // ============================================================================
@@ -11,6 +13,9 @@ public:
     virtual ~IRuntime() = default;
 
     virtual void invalidate() = 0;
+
+    // Runs a task up to its first co_await, the rest in slices (see VoltTask.hpp)
+    virtual void spawn(Task a_task) = 0;
 };
 
 }
\ No newline at end of file
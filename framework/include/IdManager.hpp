@@ -2,9 +2,11 @@
 
 #include <string>
 #include <vector>
+#include <deque>
 #include <unordered_map>
 #include <stdint.h>
 #include <memory>
+#include "StableKey.hpp"
 
 namespace volt {
 
@@ -26,13 +28,30 @@ public:
             m_nSize++;
         }
 
+        // Pushes an empty item for the caller to append to, reusing the slot's capacity
+        std::string& pushEmpty() {
+            if (m_nSize == m_stack.size()) {
+                m_stack.emplace_back();
+            }
+            std::string& sItem = m_stack[m_nSize++];
+            sItem.clear();
+            return sItem;
+        }
+
+        // ASSUMPTION! Same as pushEmpty(), starting from a copy of the top
+        std::string& pushTop() {
+            std::string& sItem = pushEmpty();
+            sItem.append(m_stack[m_nSize - 2]); // ASSUMPTION! We are assuming there is at least one item below
+            return sItem;
+        }
+
         // ASSUMPTION!
         void unsafe_pop() {
             m_nSize--; // ASSUMPTION! We are assuming there is a matching token to pop
         }
 
         // ASSUMPTION!
-        std::string unsafe_top() {
+        const std::string& unsafe_top() const {
             return m_stack[m_nSize - 1]; // ASSUMPTION! We are assuming there is at least one item
         }
 
@@ -40,8 +59,8 @@ public:
             m_nSize = 0;
         }
     private:
-        int m_nSize;
-        std::vector<std::string> m_stack;
+        size_t m_nSize;
+        std::deque<std::string> m_stack; // A deque keeps the items in place as deeper ones are pushed
     };
 
     class StableKeyBuilder {
@@ -51,9 +70,14 @@ public:
         }
 
         void pushString(const std::string& a_s) {
-            m_stack.push(m_stack.unsafe_top() + a_s);
+            m_stack.pushTop().append(a_s);
+        }
+
+        void pushToken(StableKey a_stableKey) {
+            a_stableKey.appendTo(m_stack.pushTop());
         }
 
+        // Appends the node's identity to the key in place: no formatting for compile-time tokens
         void pushVNodeToken(VNode* a_pNode);
 
         // ASSUMPTION! At least one token to pop
@@ -61,20 +85,22 @@ public:
             m_stack.unsafe_pop(); // ASSUMPTION! At least one token to pop
         }
 
-        std::string build() {
+        // Valid until this token is popped and another pushed in its place
+        const std::string& build() const {
             return m_stack.unsafe_top();
         }
     private:
         StringStack m_stack;
+        std::vector<const VNode*> m_prefixChain; // Scratch for pushVNodeToken(), innermost fragment first
     };
 
 public:
     IdManager() {}
     ~IdManager() = default;
 
-    // Starts a new generation
-    // Returns a free list of VNodes
-    void startGeneration(VNode** a_ppOutFreeListHead);
+    // Starts a new generation: the new store becomes the old one
+    // Store buckets are kept between frames, down to the recent high-water mark of nodes per frame
+    void startGeneration(size_t a_nHighWaterNodes);
 
     static std::string concatIds(std::string a_sLeftId, std::string a_sRightId) {
         if (a_sRightId.empty()) { // Nothing to add
@@ -92,29 +118,26 @@ public:
         return sId;
     }
 
-    VNode* findVNode(std::string a_sId) {
+    VNode* findVNode(const std::string& a_sId) const {
         auto it = m_oldStore.find(a_sId);
         return it != m_oldStore.end() ? it->second : nullptr;
     }
 
-    void addVNode(std::string a_sId, VNode* a_pNode) {
-        auto it = m_newStore.find(a_sId);
-        if (it != m_newStore.end()) {
+    // The key is copied only when it is inserted
+    void addVNode(const std::string& a_sId, VNode* a_pNode) {
+        if (!m_newStore.try_emplace(a_sId, a_pNode).second) {
             //log("Duplicate key detected: " + a_sId);
             m_sDuplicateKeyDescription += a_sId + ", "; // Duplicate key detected
         }
-        else {
-            m_newStore[a_sId] = a_pNode;
-        }
     }
 
 
     // StableKeyBuilder - For building stable keys during VNode construction
-    void pushIntToken(int a_nToken) { m_keyBuilder.pushString("I" + std::to_string(a_nToken) + "_"); }
+    void pushIntToken(int a_nToken) { m_keyBuilder.pushToken(StableKey(a_nToken)); }
     void pushStringToken(const std::string& a_sToken) { m_keyBuilder.pushString("S" + a_sToken + "_"); }
     void pushVNodeToken(VNode* a_pNode) { m_keyBuilder.pushVNodeToken(a_pNode); }
     void popToken() { m_keyBuilder.popToken(); }
-    std::string build() { return m_keyBuilder.build(); }
+    const std::string& build() const { return m_keyBuilder.build(); }
 
     std::string getDuplicateKeyDescription() const { return m_sDuplicateKeyDescription; }
 
@@ -5,38 +5,58 @@
 
 namespace volt {
 
-void IdManager::startGeneration(VNode** a_ppOutFreeListHead) {
-    for (auto& entry : m_oldStore) {
-        entry.second->setParent(*a_ppOutFreeListHead);
-        *a_ppOutFreeListHead = entry.second;
-    }
-    m_oldStore.clear();
-    m_oldStore = std::move(m_newStore);
+void IdManager::startGeneration(size_t a_nHighWaterNodes) {
+    // Swapping keeps both bucket arrays, so refilling the new store does not rehash every frame
+    std::swap(m_oldStore, m_newStore);
     m_newStore.clear();
+
+    // ...but a transient peak (one huge list) must not keep its buckets alive forever
+    if (m_newStore.bucket_count() > 4 * (a_nHighWaterNodes + 16)) {
+        m_newStore.rehash(0);
+        m_newStore.reserve(a_nHighWaterNodes);
+    }
+
+    m_sDuplicateKeyDescription.clear();
 }
 
 void IdManager::StableKeyBuilder::pushVNodeToken(VNode* a_pNode) {
-    std::string str = a_pNode->getIdProp();
-    if (!str.empty()) {
-        m_stack.push("D" + str + "_");
+    const std::string& sIdProp = a_pNode->getIdProp();
+    if (!sIdProp.empty()) {
+        m_stack.pushEmpty().append("D").append(sIdProp).append("_");
+        return;
     }
-    else {
-        str = a_pNode->getKeyProp();
-        if (!str.empty()) {
-            str = a_pNode->getStableKeyPrefix() + "S" + str + "_";
-        }
-        else if (a_pNode->getStableKeyPosition() >= 0) {
-            str = a_pNode->getStableKeyPrefix() + "I" + std::to_string(a_pNode->getStableKeyPosition()) + "_";
-        }
-        else {
-            emscripten_log(EM_LOG_ERROR, "Volt: VNode has no stable identity (no id, key, or stable key position)");
-        }
-        if (str.empty() || str[0] != 'D') { // Only push if not ID token
-            pushString(str);
-        } else {
-            // ID token takes precedence, push directly
-            m_stack.push(str);
+
+    const std::string& sKeyProp = a_pNode->getKeyProp();
+    const StableKey& stableKey = a_pNode->getStableKey();
+    if (sKeyProp.empty() && !stableKey.isSet()) {
+        emscripten_log(EM_LOG_ERROR, "Volt: VNode has no stable identity (no id, key, or stable key position)");
+        m_stack.pushTop();
+        return;
+    }
+
+    // Prefix: ids of the fragments the node was lifted out of, innermost first. A fragment only
+    // counts while its children were lifted further, a fragment that stayed (the root) ends the chain.
+    // ID token takes precedence: an id'd fragment starts a new key, nothing outside it counts.
+    m_prefixChain.clear();
+    bool bIdToken = false;
+    for (const VNode* pFragment = a_pNode->getPrefixFragment(); pFragment != nullptr; ) {
+        m_prefixChain.push_back(pFragment);
+        if (!pFragment->getIdProp().empty()) {
+            bIdToken = true;
+            break;
         }
+        const VNode* pInto = pFragment->getFlattenedInto();
+        pFragment = pInto->isFragment() && pInto->getFlattenedInto() != nullptr ? pInto : nullptr;
+    }
+
+    std::string& sKey = bIdToken ? m_stack.pushEmpty() : m_stack.pushTop();
+    for (auto it = m_prefixChain.rbegin(); it != m_prefixChain.rend(); ++it) {
+        (*it)->appendId(sKey);
+    }
+    if (!sKeyProp.empty()) {
+        sKey.append("S").append(sKeyProp).append("_");
+    } else {
+        stableKey.appendTo(sKey);
     }
 }
 
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+#include <emscripten/val.h>
+
+// Capture budget of an event handler in bytes, e.g. -DVOLT_HANDLER_CAPACITY=48
+#ifndef VOLT_HANDLER_CAPACITY
+#define VOLT_HANDLER_CAPACITY 32
+#endif
+
+namespace volt {
+
+// ============================================================================
+// InplaceFunction - std::function without the heap
+// ============================================================================
+// The callable is stored inside the object, so building handlers on every
+// render never allocates. Captures that don't fit are a compile error:
+// capture a pointer (this, an item*) instead of copying large state.
+
+template<typename Signature, size_t Capacity = VOLT_HANDLER_CAPACITY>
+class InplaceFunction;
+
+template<typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity> {
+public:
+    InplaceFunction() noexcept = default;
+    InplaceFunction(std::nullptr_t) noexcept {}
+
+    template<typename F, typename Fn = std::decay_t<F>,
+             typename = std::enable_if_t<!std::is_same_v<Fn, InplaceFunction> && std::is_invocable_r_v<R, Fn&, Args...>>>
+    InplaceFunction(F&& a_fn) {
+        static_assert(sizeof(Fn) <= Capacity,
+            "Volt: handler captures exceed VOLT_HANDLER_CAPACITY, capture a pointer instead of copying state");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t),
+            "Volt: handler captures are over-aligned");
+        static_assert(std::is_nothrow_move_constructible_v<Fn> && std::is_copy_constructible_v<Fn>,
+            "Volt: handlers must be copyable and nothrow movable");
+        ::new (static_cast<void*>(m_storage)) Fn(std::forward<F>(a_fn));
+        m_pOps = &s_ops<Fn>;
+    }
+
+    InplaceFunction(const InplaceFunction& a_other) : m_pOps(a_other.m_pOps) {
+        if (m_pOps) {
+            m_pOps->copy(m_storage, a_other.m_storage);
+        }
+    }
+
+    InplaceFunction(InplaceFunction&& a_other) noexcept : m_pOps(a_other.m_pOps) {
+        if (m_pOps) {
+            m_pOps->move(m_storage, a_other.m_storage);
+            a_other.m_pOps = nullptr;
+        }
+    }
+
+    InplaceFunction& operator=(const InplaceFunction& a_other) {
+        if (this != &a_other) {
+            reset();
+            if (a_other.m_pOps) {
+                a_other.m_pOps->copy(m_storage, a_other.m_storage);
+                m_pOps = a_other.m_pOps;
+            }
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& a_other) noexcept {
+        if (this != &a_other) {
+            reset();
+            if (a_other.m_pOps) {
+                a_other.m_pOps->move(m_storage, a_other.m_storage);
+                m_pOps = a_other.m_pOps;
+                a_other.m_pOps = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    ~InplaceFunction() { reset(); }
+
+    R operator()(Args... a_args) const {
+        return m_pOps->invoke(m_storage, std::forward<Args>(a_args)...);
+    }
+
+    explicit operator bool() const noexcept { return m_pOps != nullptr; }
+
+    void reset() noexcept {
+        if (m_pOps) {
+            m_pOps->destroy(m_storage);
+            m_pOps = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        R    (*invoke)(void* a_pStorage, Args&&... a_args);
+        void (*copy)(void* a_pDst, const void* a_pSrc);
+        void (*move)(void* a_pDst, void* a_pSrc) noexcept; // Also destroys the source
+        void (*destroy)(void* a_pStorage) noexcept;
+    };
+
+    template<typename Fn>
+    static constexpr Ops s_ops = {
+        [](void* a_pStorage, Args&&... a_args) -> R {
+            return (*static_cast<Fn*>(a_pStorage))(std::forward<Args>(a_args)...);
+        },
+        [](void* a_pDst, const void* a_pSrc) {
+            ::new (a_pDst) Fn(*static_cast<const Fn*>(a_pSrc));
+        },
+        [](void* a_pDst, void* a_pSrc) noexcept {
+            ::new (a_pDst) Fn(std::move(*static_cast<Fn*>(a_pSrc)));
+            static_cast<Fn*>(a_pSrc)->~Fn();
+        },
+        [](void* a_pStorage) noexcept {
+            static_cast<Fn*>(a_pStorage)->~Fn();
+        },
+    };
+
+    alignas(std::max_align_t) mutable unsigned char m_storage[Capacity];
+    const Ops* m_pOps = nullptr;
+};
+
+// Handler of DOM events and element lifecycle hooks
+typedef InplaceFunction<void(emscripten::val)> EventHandler;
+
+} // namespace volt
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+#include <charconv>
+
+namespace volt {
+
+// ============================================================================
+// StableKey - Position of a node among its siblings
+// ============================================================================
+// Either a token rendered at compile time for a call site (VOLT_KEY, VOLT_TRACK)
+// or a runtime index (loop(), map(), track(i)). Appending it to a key never
+// allocates beyond the key's capacity.
+//
+// Compile-time tokens are "T" + translation unit code + call site code + "_",
+// using the two-character codes of counter_codes.txt. The translation unit
+// code is -DVOLT_TU_ID=<0..3338>, 0 when not given. Tokens are unique as long
+// as the ids are: every translation unit that includes this header defines a
+// symbol named after its id, so two of them with the same id (or two without
+// one) fail to link instead of sharing keys.
+
+// Two-character codes: a letter or '_', then a letter, digit or '_'
+inline constexpr char g_sStableKeyCodes[] =
+#include "counter_codes.txt"
+;
+inline constexpr uint32_t STABLE_KEY_CODE_COUNT = (sizeof(g_sStableKeyCodes) - 1) / 2;
+static_assert(STABLE_KEY_CODE_COUNT == 3339, "Volt: counter_codes.txt must hold 53 * 63 codes");
+
+// Pre-rendered token of one call site
+struct StableKeyText {
+    char chars[8];
+    uint8_t length;
+};
+
+constexpr StableKeyText makeStableKeyText(uint32_t a_nTranslationUnit, uint32_t a_nCallSite) {
+    StableKeyText text{};
+    auto appendCode = [&text](uint32_t a_nCode) {
+        text.chars[text.length++] = g_sStableKeyCodes[2 * a_nCode];
+        text.chars[text.length++] = g_sStableKeyCodes[2 * a_nCode + 1];
+    };
+    text.chars[text.length++] = 'T';
+    appendCode(a_nTranslationUnit % STABLE_KEY_CODE_COUNT);
+    appendCode(a_nCallSite % STABLE_KEY_CODE_COUNT);
+    if (a_nCallSite >= STABLE_KEY_CODE_COUNT) {
+        appendCode((a_nCallSite / STABLE_KEY_CODE_COUNT) % STABLE_KEY_CODE_COUNT); // More than 3339 call sites in one TU
+    }
+    text.chars[text.length++] = '_';
+    return text;
+}
+
+template<uint32_t TranslationUnit, uint32_t CallSite>
+inline constexpr StableKeyText g_stableKeyText = makeStableKeyText(TranslationUnit, CallSite);
+
+class StableKey {
+public:
+    constexpr StableKey() noexcept = default;
+    constexpr StableKey(int a_nIndex) noexcept : m_nIndex(a_nIndex) {}
+    constexpr StableKey(const StableKeyText& a_text) noexcept : m_pText(&a_text) {}
+
+    constexpr bool isSet() const noexcept { return m_pText != nullptr || m_nIndex >= 0; }
+
+    // Appends "T<codes>_" or "I<index>_"
+    void appendTo(std::string& a_sKey) const {
+        if (m_pText != nullptr) {
+            a_sKey.append(m_pText->chars, m_pText->length);
+            return;
+        }
+        char buffer[16];
+        buffer[0] = 'I';
+        char* pEnd = std::to_chars(buffer + 1, buffer + sizeof(buffer) - 1, m_nIndex).ptr;
+        *pEnd++ = '_';
+        a_sKey.append(buffer, pEnd - buffer);
+    }
+
+private:
+    const StableKeyText* m_pText = nullptr;
+    int m_nIndex = -1;
+};
+
+} // namespace volt
+
+// ---- Public macros --------------------------------------------------------
+
+// Id of this translation unit, a plain integer literal: -DVOLT_TU_ID=3
+#ifndef VOLT_TU_ID
+    #define VOLT_TU_ID 0
+#else
+    #define VOLT_TU_ID_GIVEN
+#endif
+static_assert(VOLT_TU_ID >= 0 && VOLT_TU_ID < ::volt::STABLE_KEY_CODE_COUNT, "Volt: VOLT_TU_ID must be in 0..3338");
+
+#define VOLT_TU_CODE (static_cast<uint32_t>(VOLT_TU_ID))
+
+// Defined once per given id: a duplicate definition at link time means two translation units share
+// VOLT_TU_ID. Translation units without an id all use 0 and are not checked.
+#ifdef VOLT_TU_ID_GIVEN
+    #define VOLT_TU_SYMBOL_(a_nId) volt_stable_key_duplicate_VOLT_TU_ID_##a_nId
+    #define VOLT_TU_SYMBOL(a_nId) VOLT_TU_SYMBOL_(a_nId)
+    extern "C" const unsigned char VOLT_TU_SYMBOL(VOLT_TU_ID) = 0;
+#endif
+
+// Compile-time stable key of this call site, e.g. tag::li("x").track(VOLT_KEY)
+#define VOLT_KEY (::volt::StableKey(::volt::g_stableKeyText<VOLT_TU_CODE, __COUNTER__>))
+
+// node.VOLT_TRACK is node.track(VOLT_KEY), the form written by the X preprocessor
+#define VOLT_TRACK track(VOLT_KEY)
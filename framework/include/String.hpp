@@ -33,6 +33,10 @@ EM_JS(bool, js_string_equals, (EM_VAL a_hS1, EM_VAL a_hS2), {
     return js_val1 === js_val2;
 });
 
+namespace volt {
+
+// JS string held by handle. As a prop or text value (attr::title(s), tag::p(s)) it is
+// diffed by handle, then with ===, and handed to the DOM as is: it never crosses into wasm.
 class String {
 public:
     String() {
@@ -91,6 +95,12 @@ public:
         return emscripten::val::take_ownership(m_handle).as<std::string>();
     }
 
+    // Shares the handle, e.g. to store it in a VNode or pass it to the DOM
+    emscripten::val toVal() const {
+        emscripten::internal::_emval_incref(m_handle);
+        return emscripten::val::take_ownership(m_handle);
+    }
+
     size_t length() const {
         return js_string_length(m_handle);
     }
@@ -99,20 +109,27 @@ public:
         return String(js_string_concat(m_handle, other.m_handle));
     }
 
+    // Same handle first, no JS call
     bool operator==(const String& other) const {
-        return js_string_equals(m_handle, other.m_handle);
+        return m_handle == other.m_handle || js_string_equals(m_handle, other.m_handle);
     }
 
     bool operator!=(const String& other) const {
-        return !js_string_equals(m_handle, other.m_handle);
+        return !(*this == other);
     }
 
 private:
     EM_VAL m_handle;
 };
 
-#define S(text) String(text)
-
 inline String str(int n) {
     return String(i32_to_js_string(n));
-}
\ No newline at end of file
+}
+
+} // namespace volt
+
+// Declared globally before Volt moved it into its namespace
+using volt::String;
+using volt::str;
+
+#define S(text) String(text)
\ No newline at end of file
@@ -17,62 +17,92 @@ inline const char* tagToString(ETag tag);
 
 // Macro to generate overloads for a tag using variadic templates
 // This allows natural syntax: div({props}, child1, child2, "text", ...)
+// A brace list of props binds to an array, so props are moved out of the call site,
+// and children are forwarded straight into the node instead of through a vector.
 #define VNODE_TAG_HELPER(tagName, tagEnum) \
     inline VNodeHandle tagName() { \
-        return VNodeHandle(tag::ETag::tagEnum, {}, {}); \
+        return VNodeHandle(tag::ETag::tagEnum, VNodeHandle::NoProps{}); \
     } \
-    inline VNodeHandle tagName(std::vector<std::pair<short, PropValueType>> props) { \
-        return VNodeHandle(tag::ETag::tagEnum, std::move(props), {}); \
+    template<size_t N, typename... Children> \
+    inline VNodeHandle tagName(VNodeHandle::Prop (&&props)[N], Children&&... children) { \
+        return VNodeHandle(tag::ETag::tagEnum, std::move(props), std::forward<Children>(children)...); \
     } \
     template<typename... Children> \
-    inline VNodeHandle tagName(Children&&... children) { \
-        return VNodeHandle(tag::ETag::tagEnum, {}, {std::forward<Children>(children)...}); \
+    inline VNodeHandle tagName(VNodeHandle::NoProps props, Children&&... children) { \
+        return VNodeHandle(tag::ETag::tagEnum, props, std::forward<Children>(children)...); \
+    } \
+    template<typename Props, typename... Children> \
+        requires VNodeHandle::IsPropVector<Props> \
+    inline VNodeHandle tagName(Props&& props, Children&&... children) { \
+        return VNodeHandle(tag::ETag::tagEnum, std::forward<Props>(props), std::forward<Children>(children)...); \
     } \
     template<typename... Children> \
-    inline VNodeHandle tagName(std::vector<std::pair<short, PropValueType>> props, Children&&... children) { \
-        return VNodeHandle(tag::ETag::tagEnum, std::move(props), {std::forward<Children>(children)...}); \
+    inline VNodeHandle tagName(Children&&... children) { \
+        return VNodeHandle(tag::ETag::tagEnum, VNodeHandle::NoProps{}, std::forward<Children>(children)...); \
     } \
-    inline VNodeHandle tagName##_if(int stableKeyPositionT, int stableKeyPositionF, bool condition) { \
+    inline VNodeHandle tagName##_if(StableKey stableKeyT, StableKey stableKeyF, bool condition) { \
         if (condition) \
-            return VNodeHandle(tag::ETag::tagEnum, {}, {}).track(stableKeyPositionT); \
-        return _fragment().track(stableKeyPositionF); \
+            return VNodeHandle(tag::ETag::tagEnum, VNodeHandle::NoProps{}).track(stableKeyT); \
+        return _fragment().track(stableKeyF); \
     } \
-    inline VNodeHandle tagName##_if(int stableKeyPositionT, int stableKeyPositionF, bool condition, std::vector<std::pair<short, PropValueType>> props) { \
+    template<size_t N, typename... Children> \
+    inline VNodeHandle tagName##_if(StableKey stableKeyT, StableKey stableKeyF, bool condition, VNodeHandle::Prop (&&props)[N], Children&&... children) { \
         if (condition) \
-            return VNodeHandle(tag::ETag::tagEnum, std::move(props), {}).track(stableKeyPositionT); \
-        return _fragment().track(stableKeyPositionF); \
+            return VNodeHandle(tag::ETag::tagEnum, std::move(props), std::forward<Children>(children)...).track(stableKeyT); \
+        return _fragment().track(stableKeyF); \
     } \
     template<typename... Children> \
-    inline VNodeHandle tagName##_if(int stableKeyPositionT, int stableKeyPositionF, bool condition, Children&&... children) { \
+    inline VNodeHandle tagName##_if(StableKey stableKeyT, StableKey stableKeyF, bool condition, VNodeHandle::NoProps props, Children&&... children) { \
+        if (condition) \
+            return VNodeHandle(tag::ETag::tagEnum, props, std::forward<Children>(children)...).track(stableKeyT); \
+        return _fragment().track(stableKeyF); \
+    } \
+    template<typename Props, typename... Children> \
+        requires VNodeHandle::IsPropVector<Props> \
+    inline VNodeHandle tagName##_if(StableKey stableKeyT, StableKey stableKeyF, bool condition, Props&& props, Children&&... children) { \
         if (condition) \
-            return VNodeHandle(tag::ETag::tagEnum, {}, {std::forward<Children>(children)...}).track(stableKeyPositionT); \
-        return _fragment().track(stableKeyPositionF); \
+            return VNodeHandle(tag::ETag::tagEnum, std::forward<Props>(props), std::forward<Children>(children)...).track(stableKeyT); \
+        return _fragment().track(stableKeyF); \
     } \
     template<typename... Children> \
-    inline VNodeHandle tagName##_if(int stableKeyPositionT, int stableKeyPositionF, bool condition, std::vector<std::pair<short, PropValueType>> props, Children&&... children) { \
+    inline VNodeHandle tagName##_if(StableKey stableKeyT, StableKey stableKeyF, bool condition, Children&&... children) { \
         if (condition) \
-            return VNodeHandle(tag::ETag::tagEnum, std::move(props), {std::forward<Children>(children)...}).track(stableKeyPositionT); \
-        return _fragment().track(stableKeyPositionF); \
+            return VNodeHandle(tag::ETag::tagEnum, VNodeHandle::NoProps{}, std::forward<Children>(children)...).track(stableKeyT); \
+        return _fragment().track(stableKeyF); \
     }
 
 
 // Macro for self-closing tags (no children): (props), ()
 #define VNODE_SELFCLOSING_HELPER(tagName, tagEnum) \
-    inline VNodeHandle tagName(std::vector<std::pair<short, PropValueType>> props) { \
-        return VNodeHandle(tag::ETag::tagEnum, std::move(props), {}); \
+    template<size_t N> \
+    inline VNodeHandle tagName(VNodeHandle::Prop (&&props)[N]) { \
+        return VNodeHandle(tag::ETag::tagEnum, std::move(props)); \
     } \
-    inline VNodeHandle tagName() { \
-        return VNodeHandle(tag::ETag::tagEnum, {}, {}); \
+    template<typename Props> \
+        requires VNodeHandle::IsPropVector<Props> \
+    inline VNodeHandle tagName(Props&& props) { \
+        return VNodeHandle(tag::ETag::tagEnum, std::forward<Props>(props)); \
+    } \
+    inline VNodeHandle tagName(VNodeHandle::NoProps props = {}) { \
+        return VNodeHandle(tag::ETag::tagEnum, props); \
+    } \
+    template<size_t N> \
+    inline VNodeHandle tagName##_if(StableKey stableKeyT, StableKey stableKeyF, bool condition, VNodeHandle::Prop (&&props)[N]) { \
+        if (condition) \
+            return VNodeHandle(tag::ETag::tagEnum, std::move(props)).track(stableKeyT); \
+        return _fragment().track(stableKeyF); \
     } \
-    inline VNodeHandle tagName##_if(int stableKeyPositionT, int stableKeyPositionF, bool condition, std::vector<std::pair<short, PropValueType>> props) { \
+    template<typename Props> \
+        requires VNodeHandle::IsPropVector<Props> \
+    inline VNodeHandle tagName##_if(StableKey stableKeyT, StableKey stableKeyF, bool condition, Props&& props) { \
         if (condition) \
-            return VNodeHandle(tag::ETag::tagEnum, std::move(props), {}).track(stableKeyPositionT); \
-        return _fragment().track(stableKeyPositionF); \
+            return VNodeHandle(tag::ETag::tagEnum, std::forward<Props>(props)).track(stableKeyT); \
+        return _fragment().track(stableKeyF); \
     } \
-    inline VNodeHandle tagName##_if(int stableKeyPositionT, int stableKeyPositionF, bool condition) { \
+    inline VNodeHandle tagName##_if(StableKey stableKeyT, StableKey stableKeyF, bool condition, VNodeHandle::NoProps props = {}) { \
         if (condition) \
-            return VNodeHandle(tag::ETag::tagEnum, {}, {}).track(stableKeyPositionT); \
-        return _fragment().track(stableKeyPositionF); \
+            return VNodeHandle(tag::ETag::tagEnum, props).track(stableKeyT); \
+        return _fragment().track(stableKeyF); \
     }
 
 // Text Node
@@ -1,4 +1,5 @@
 #include "Tags.hpp"
+#include <array>
 #include <vector>
 #include <string>
 #include <memory>
@@ -9,8 +10,8 @@ namespace volt {
 
 namespace tag {
 
-// Helper to convert Tag enum to string
-inline const char* tagToString(ETag a_nTag) {
+// Only evaluated at compile time to fill g_tagNames, use tagToString() instead
+constexpr const char* tagNameOf(ETag a_nTag) {
     switch (a_nTag) {
         case ETag::_TEXT: return "#text";
         case ETag::_FRAGMENT: return "#fragment";
@@ -207,6 +208,21 @@ inline const char* tagToString(ETag a_nTag) {
     }
 }
 
+// Tag names indexed by ETag, built at compile time
+inline constexpr std::array<const char*, static_cast<size_t>(ETag::_COUNT)> g_tagNames = [] {
+    std::array<const char*, static_cast<size_t>(ETag::_COUNT)> names{};
+    for (size_t i = 0; i < names.size(); ++i) {
+        names[i] = tagNameOf(static_cast<ETag>(i));
+    }
+    return names;
+}();
+
+// Helper to convert Tag enum to string
+inline const char* tagToString(ETag a_nTag) {
+    size_t nIdx = static_cast<size_t>(a_nTag);
+    return nIdx < g_tagNames.size() ? g_tagNames[nIdx] : "div";
+}
+
 } // namespace tag
 
 } // namespace volt
\ No newline at end of file
@@ -7,13 +7,19 @@
 #include <functional>
 #include <unordered_map>
 #include <map>
+#include <stdint.h>
 #include "Attrs.hpp"
 #include "ETags.hpp"
 #include "Tags.hpp"
 #include "VNodeHandle.hpp"
+#include "StableKey.hpp"
+#include "VNodeTable.hpp"
+#include "VoltFormat.hpp"
 
 namespace volt {
 
+class VoltEngine;
+
 // ============================================================================
 // VNode - Virtual DOM Node
 // ============================================================================
@@ -26,33 +32,37 @@ public:
     // Runtime functions
     // -----
 
-    bool bubbleCallback(std::string a_eventName, emscripten::val a_event) {
-        auto it = m_bubbleEvents.find(a_eventName);
-        if (it != m_bubbleEvents.end()) {
-            it->second(a_event);
-            return true;
+    // Handlers are few per node, a scan beats a map and needs no rebuilding.
+    // The caller invalidates the owning engine when a handler ran.
+    bool bubbleCallback(const std::string& a_eventName, emscripten::val a_event) {
+        for (const auto& [eventAttrId, handler] : m_bubbleEvents) {
+            if (a_eventName == attr::attrIdToName(eventAttrId)) {
+                handler(a_event);
+                return true;
+            }
         }
         return false;
     }
-    bool nonBubbleCallback(std::string a_eventName, emscripten::val a_event) {
-        auto it = m_nonBubbleEventsByName.find(a_eventName);
-        if (it != m_nonBubbleEventsByName.end()) {
-            it->second(a_event);
-            return true;
+    bool nonBubbleCallback(const std::string& a_eventName, emscripten::val a_event) {
+        for (const auto& [eventAttrId, handler] : m_nonBubbleEvents) {
+            if (a_eventName == attr::attrIdToName(eventAttrId)) {
+                handler(a_event);
+                return true;
+            }
         }
         return false;
     }
     void onAddElement(emscripten::val a_element) {
-        m_onAddElementEvent(a_element);
+        if (m_onAddElementEvent) m_onAddElementEvent(a_element);
     }
     void onBeforeMoveElement(emscripten::val a_element) {
-        m_onBeforeMoveElementEvent(a_element);
+        if (m_onBeforeMoveElementEvent) m_onBeforeMoveElementEvent(a_element);
     }
     void onMoveElement(emscripten::val a_element) {
-        m_onMoveElementEvent(a_element);
+        if (m_onMoveElementEvent) m_onMoveElementEvent(a_element);
     }
     void onRemoveElement(emscripten::val a_element) {
-        m_onRemoveElementEvent(a_element);
+        if (m_onRemoveElementEvent) m_onRemoveElementEvent(a_element);
     }
 
     // Render functions
@@ -60,60 +70,97 @@ public:
     tag::ETag getTag() { return m_nTag; }
     std::string getTagName() { return tag::tagToString(m_nTag); }
     std::vector<std::pair<short, std::string>>& getProps() { return m_props; }
-    std::string getKeyProp() { return m_sKeyProp; }
-    std::string getIdProp() { return m_sIdProp; }
-    std::string getStableKeyPrefix() const { return m_sStableKeyPrefix; }
-    std::string getId() { 
-        std::string str = getIdProp();
-        if (!str.empty()) {
-            return "D" + str + "_";
-        }
-        str = getKeyProp();
-        if (!str.empty()) {
-            return "S" + str + "_";
-        }
-        if (m_nStableKeyPosition >= 0) {
-            return "I" + std::to_string(m_nStableKeyPosition) + "_";
+    std::vector<std::pair<short, emscripten::val>>& getJsProps() { return m_jsProps; }
+    std::vector<attr::StyleProp>& getStyleProps() { return m_styleProps; }
+    std::vector<attr::SharedText>& getClassTokens() { return m_classTokens; }
+    std::vector<attr::AnimatedProp>& getAnimatedProps() { return m_animatedProps; }
+    const std::string& getKeyProp() const { return m_sKeyProp; }
+    const std::string& getIdProp() const { return m_sIdProp; }
+    // Appends this node's own key token ("D<id>_", "S<key>_", "T..._" or "I<index>_")
+    void appendId(std::string& a_sKey) const { 
+        if (!m_sIdProp.empty()) {
+            a_sKey.append("D").append(m_sIdProp).append("_");
+        } else if (!m_sKeyProp.empty()) {
+            a_sKey.append("S").append(m_sKeyProp).append("_");
+        } else if (m_stableKey.isSet()) {
+            m_stableKey.appendTo(a_sKey);
+        } else {
+            a_sKey.append("UNKNOWN_");
         }
-        return "UNKNOWN_";
      }
-    int getStableKeyPosition() { return m_nStableKeyPosition; }
-    std::unordered_map<std::string, std::function<void(emscripten::val)>>& getBubbleEvents() { return m_bubbleEvents; }
-    std::vector<std::pair<short, std::function<void(emscripten::val)>>>& getNonBubbleEvents() { return m_nonBubbleEvents; }
+    const StableKey& getStableKey() const { return m_stableKey; }
+
+    // Key prefix chain, see VNodeHandle::addChild(): the fragment this node was first lifted out of,
+    // then for each fragment the node its children were lifted into. Resolved by the IdManager.
+    VNode* getPrefixFragment() const { return m_pPrefixFragment; }
+    VNode* getFlattenedInto() const { return m_pFlattenedInto; }
+    std::vector<std::pair<short, EventHandler>>& getBubbleEvents() { return m_bubbleEvents; }
+    std::vector<std::pair<short, EventHandler>>& getNonBubbleEvents() { return m_nonBubbleEvents; }
     std::vector<VNode*>& getChildren() { return m_children; }
 
     // Setup VNode data
     void reuse(tag::ETag a_nTag);
-    void setStableKeyPrefix(const std::string& a_sStableKeyPrefix) { m_sStableKeyPrefix = a_sStableKeyPrefix; }
-    void setStableKeyPosition(int a_stableKeyPosition) { m_nStableKeyPosition = a_stableKeyPosition; }
+    void setPrefixFragment(VNode* a_pFragment) { m_pPrefixFragment = a_pFragment; }
+    void setFlattenedInto(VNode* a_pNode) { m_pFlattenedInto = a_pNode; }
+    void setStableKey(StableKey a_stableKey) { m_stableKey = a_stableKey; }
     void setIdProp(const std::string& a_sIdProp) { m_sIdProp = a_sIdProp; }
     void setKeyProp(const std::string& a_sKeyProp) { m_sKeyProp = a_sKeyProp; }
     void setProps(std::vector<std::pair<short, std::string>> a_props);
-    void setBubbleEvents(std::unordered_map<std::string, std::function<void(emscripten::val)>> a_events);
-    void setOnAddElementEvent(std::function<void(emscripten::val)> a_fn) { m_onAddElementEvent = a_fn; }
-    void setOnBeforeMoveElementEvent(std::function<void(emscripten::val)> a_fn) { m_onBeforeMoveElementEvent = a_fn; }
-    void setOnMoveElementEvent(std::function<void(emscripten::val)> a_fn) { m_onMoveElementEvent = a_fn; }
-    void setOnRemoveElementEvent(std::function<void(emscripten::val)> a_fn) { m_onRemoveElementEvent = a_fn; }
-    void setNonBubbleEvents(std::vector<std::pair<short, std::function<void(emscripten::val)>>> a_events);
+    void setStyleProps(std::vector<attr::StyleProp> a_styleProps);
+    void setClassTokens(std::vector<attr::SharedText> a_classTokens);
+    void setBubbleEvents(std::vector<std::pair<short, EventHandler>> a_events);
+    void setOnAddElementEvent(EventHandler a_fn) { m_onAddElementEvent = std::move(a_fn); }
+    void setOnBeforeMoveElementEvent(EventHandler a_fn) { m_onBeforeMoveElementEvent = std::move(a_fn); }
+    void setOnMoveElementEvent(EventHandler a_fn) { m_onMoveElementEvent = std::move(a_fn); }
+    void setOnRemoveElementEvent(EventHandler a_fn) { m_onRemoveElementEvent = std::move(a_fn); }
+    void setNonBubbleEvents(std::vector<std::pair<short, EventHandler>> a_events);
     void setChildren(std::vector<VNode*> a_children);
 
+    // Sorts props appended in place through the getters, as the setters do
+    void finishProps();
+
     // Set as text node
     void setAsText(std::string a_sTextContent);
 
+    // Set as text node kept as numbers, formatted only when the text is needed
+    void setAsText(const Format& a_format);
+    bool isFormattedText() const { return m_bFormattedText; }
+    const Format& getTextFormat() const { return m_textFormat; }
+
+    // Set as text node whose content stays in JS
+    void setAsText(const String& a_sTextContent);
+    bool isJsText() const { return !m_jsText.isUndefined(); }
+    const emscripten::val& getJsText() const { return m_jsText; }
+
     // Check if this is a text node
     bool isText() const { return m_nTag == tag::ETag::_TEXT; }
     
     // Check if this is a fragment node
     bool isFragment() const { return m_nTag == tag::ETag::_FRAGMENT; }
 
-    // Get text content (only valid for TEXT nodes)
-    std::string getText() const;
+    // Get text content (only valid for TEXT nodes). NUL-terminated, formatted text
+    // lives in the TextArena and is only valid until the next render.
+    std::string_view getText() const;
+
+    // Markup of this subtree as the DOM should look, for verify reports and snapshots.
+    // Fragments contribute only their children.
+    void appendHtml(std::string& a_sHtml) const;
+    std::string toHtml() const { std::string sHtml; appendHtml(sHtml); return sHtml; }
 
     // Intrusive
     emscripten::val getMatchingElement() const { return m_matchingElement; }
     void setMatchingElement(emscripten::val a_element) { m_matchingElement = a_element; }
     void setParent(VNode* a_pParent) { m_pParent = a_pParent; }
     VNode* getParent() const { return m_pParent; }
+    void setEngine(VoltEngine* a_pEngine) { m_pEngine = a_pEngine; }
+    VoltEngine* getEngine() const { return m_pEngine; }
+    void setNodeId(VNodeId a_nId) { m_nId = a_nId; }
+    VNodeId getNodeId() const { return m_nId; }
+    // This node's element is focused or contains the focused element, see FocusManager
+    void setFocusWithin(bool a_bFocusWithin) { m_bFocusWithin = a_bFocusWithin; }
+    bool hasFocusWithin() const { return m_bFocusWithin; }
+    void setGeneration(uint32_t a_nGeneration) { m_nGeneration = a_nGeneration; }
+    uint32_t getGeneration() const { return m_nGeneration; }
     void unlink() {
         if (m_pParent) {
             bool found = m_pParent->m_children[0] == this;
@@ -129,25 +176,47 @@ public:
     }
 
 private:
-    std::unordered_map<std::string, std::function<void(emscripten::val)>> m_bubbleEvents;
-    std::vector<std::pair<short, std::function<void(emscripten::val)>>> m_nonBubbleEvents; // Kept sorted for efficient diffing
-    std::unordered_map<std::string, std::function<void(emscripten::val)>> m_nonBubbleEventsByName;
-    std::function<void(emscripten::val)> m_onAddElementEvent;
-    std::function<void(emscripten::val)> m_onBeforeMoveElementEvent;
-    std::function<void(emscripten::val)> m_onMoveElementEvent;
-    std::function<void(emscripten::val)> m_onRemoveElementEvent;
+    void sortProps();
+    void sortJsProps();
+    void sortStyleProps();
+    void sortClassTokens();
+    void sortNonBubbleEvents();
+
+    std::vector<std::pair<short, EventHandler>> m_bubbleEvents; // One per event, dispatched through the root
+    std::vector<std::pair<short, EventHandler>> m_nonBubbleEvents; // Kept sorted for efficient diffing
+    EventHandler m_onAddElementEvent;
+    EventHandler m_onBeforeMoveElementEvent;
+    EventHandler m_onMoveElementEvent;
+    EventHandler m_onRemoveElementEvent;
 
     tag::ETag m_nTag;
+    bool m_bFocusWithin = false; // Packs next to the tag, the 32-bit ids below then fill their 8 bytes
     std::vector<std::pair<short, std::string>> m_props; // Kept sorted for efficient diffing
+    std::vector<std::pair<short, emscripten::val>> m_jsProps; // volt::String values, kept sorted as well
+    std::vector<attr::StyleProp> m_styleProps; // Kept sorted by property for efficient diffing
+    std::vector<attr::SharedText> m_classTokens; // Kept sorted and unique for efficient diffing
+    std::vector<attr::AnimatedProp> m_animatedProps; // Written by their Animated each frame, not by the diff
     std::vector<VNode*> m_children;
-    std::string m_sStableKeyPrefix; // This is transferred from fragment parents to children when flattening, sometimes multiple levels deep
-    int m_nStableKeyPosition; // Positional key token
+    StableKey m_stableKey; // Positional key token, compile-time (VOLT_KEY) or a runtime index
     std::string m_sIdProp; // Cached id prop for quick access
     std::string m_sKeyProp; // Cached key prop for quick access
 
     // Intrusive storage for efficient reconciliation
     emscripten::val m_matchingElement = emscripten::val::undefined();  // Associated DOM element handle when available
     VNode* m_pParent = nullptr; // Needed to remove from parent during diff/patch
+    VNode* m_pPrefixFragment = nullptr; // Fragment this node was lifted out of, head of its key prefix chain
+    VNode* m_pFlattenedInto = nullptr; // Fragments only: the node that took the children
+    VoltEngine* m_pEngine = nullptr; // Owner of the pool, invalidated after a handler ran
+    uint32_t m_nGeneration = 0; // Render that last built this node, see VoltEngine::reclaimVNodes()
+    VNodeId m_nId = 0; // Handle in the VNodeTable, pooled nodes only; the DOM element's __volt_node
+
+    // Formatted text nodes: raw values, and their text in the TextArena once needed
+    Format m_textFormat;
+    mutable std::string_view m_sFormattedText;
+    mutable uint32_t m_nFormattedEpoch = 0; // TextArena epoch of m_sFormattedText
+    bool m_bFormattedText = false;
+
+    emscripten::val m_jsText = emscripten::val::undefined(); // volt::String text nodes
 };
 
 // ============================================================================
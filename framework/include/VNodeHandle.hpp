@@ -5,8 +5,13 @@
 #include <memory>
 #include <algorithm>
 #include <functional>
+#include <variant>
+#include <iterator>
+#include <type_traits>
 #include "Attrs.hpp"
 #include "ETags.hpp"
+#include "StableKey.hpp"
+#include "VoltFormat.hpp"
 
 namespace volt {
 
@@ -16,22 +21,63 @@ class VNode;
 // VNodeHandle - Virtual DOM Node Handle
 // ============================================================================
 
-typedef std::variant<std::string, std::function<void(emscripten::val)>> PropValueType;
+typedef std::variant<std::string, EventHandler, attr::StyleProp, attr::SharedText, attr::AnimatedProp, String> PropValueType;
 
 // Node wrapper, so C++ compiler allows for adding text nodes conveniently
 class VNodeHandle {
 public:
-    VNodeHandle(tag::ETag a_nTag, std::vector<std::pair<short, PropValueType>> a_props = {}, std::vector<VNodeHandle> a_children = {});
+    typedef std::pair<short, PropValueType> Prop;
+
+    // Tag for "no props", also what an empty brace list `{}` converts to
+    struct NoProps {};
+
+    // Props as a brace list, deduced as an array so nothing is copied into an initializer_list
+    template<typename T>
+    static constexpr bool IsPropArray = std::is_array_v<std::remove_reference_t<T>> &&
+        std::is_same_v<std::remove_cv_t<std::remove_extent_t<std::remove_reference_t<T>>>, Prop>;
+
+    // Props as returned by volt::props(), an explicit vector is still accepted
+    template<typename T>
+    static constexpr bool IsPropVector = std::is_same_v<std::remove_cvref_t<T>, std::vector<Prop>>;
+
+    template<typename T>
+    static constexpr bool IsPropsArg = std::is_same_v<std::remove_cvref_t<T>, NoProps> || IsPropArray<T> || IsPropVector<T>;
+
+    VNodeHandle(tag::ETag a_nTag, std::vector<Prop> a_props = {}, std::vector<VNodeHandle> a_children = {});
     VNodeHandle(std::string a_sTextContent);
     VNodeHandle(const char * a_sTextContent);
 
-    inline VNodeHandle track(int a_nStableKeyPosition) const;
+    // Text that stays in JS, written to the DOM by handle, see String.hpp
+    VNodeHandle(const String& a_sTextContent);
+
+    // Text kept as numbers, see Format: tag::td(nCount), tag::p(volt::fmt("{:.1f} %", nLoad))
+    VNodeHandle(const Format& a_format);
+    template<typename T>
+        requires (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>)
+    VNodeHandle(T a_nNumber) : VNodeHandle(Format("{}", a_nNumber)) {}
+
+    // Builds straight into the recycled VNode: props are moved out of the caller's
+    // brace list (a stack array) or vector, children are appended without a temporary vector
+    template<typename Props, typename... Children>
+        requires VNodeHandle::IsPropsArg<Props>
+    VNodeHandle(tag::ETag a_nTag, Props&& a_props, Children&&... a_children);
+
+    // Stable position among the siblings: VOLT_KEY (or .VOLT_TRACK) at a call site, an index in loops
+    inline VNodeHandle track(StableKey a_stableKey) const;
     inline VNode * getNodePtr() const { return m_pNode; }
 
     static VNodeHandle wrap(VNode * a_pNode);
     
 private:
     VNodeHandle(VNode * a_pNode);
+
+    void beginNode(tag::ETag a_nTag);
+    void addProp(Prop&& a_prop);
+    void addProp(const Prop& a_prop) { addProp(Prop(a_prop)); }
+    void addChild(const VNodeHandle& a_child);
+    void addChild(const std::vector<VNodeHandle>& a_children);
+    void endNode();
+
     VNode * m_pNode;
 };
 
@@ -4,11 +4,13 @@
 #include <memory>
 #include <algorithm>
 #include <functional>
+#include <utility>
 #include "VNodeHandle.hpp"
 #include "VNode.hpp"
 #include "RenderingEngine.hpp"
 #include "VoltEngine.hpp"
 #include "EventBridge.hpp"
+#include "VoltProfiler.hpp"
 
 namespace volt {
 
@@ -17,111 +19,193 @@ namespace volt {
 // ============================================================================
 
 // ASSUMPTION! Constructor with stable key, assumed to be non-default
-VNodeHandle::VNodeHandle(tag::ETag a_nTag, std::vector<std::pair<short, PropValueType>> a_props, std::vector<VNodeHandle> a_children) {
+VNodeHandle::VNodeHandle(tag::ETag a_nTag, std::vector<Prop> a_props, std::vector<VNodeHandle> a_children) {
+    VOLT_PROFILE_SCOPE(buildMs);
+    beginNode(a_nTag);
+    for (auto& prop : a_props) {
+        addProp(std::move(prop));
+    }
+    addChild(a_children);
+    endNode();
+}
+
+template<typename Props, typename... Children>
+    requires VNodeHandle::IsPropsArg<Props>
+VNodeHandle::VNodeHandle(tag::ETag a_nTag, Props&& a_props, Children&&... a_children) {
+    {
+        VOLT_PROFILE_SCOPE(buildMs);
+        beginNode(a_nTag);
+        if constexpr (!std::is_same_v<std::remove_cvref_t<Props>, NoProps>) {
+            for (auto& prop : a_props) {
+                if constexpr (std::is_lvalue_reference_v<Props>) {
+                    addProp(std::as_const(prop)); // Caller keeps its vector
+                } else {
+                    addProp(std::move(prop));
+                }
+            }
+        }
+        m_pNode->getChildren().reserve(sizeof...(Children));
+    }
+
+    // Outside the scope: text children are converted here and time their own build
+    (addChild(std::forward<Children>(a_children)), ...);
+
+    VOLT_PROFILE_SCOPE(buildMs);
+    endNode();
+}
+
+void VNodeHandle::beginNode(tag::ETag a_nTag) {
+    // The recycled node keeps the capacity of its vectors, props and children are appended in place
     m_pNode = g_pRenderingEngine->recycleVNode();
     m_pNode->reuse(a_nTag);
+}
 
-    // Separate props into attributes and event handlers
-    std::vector<std::pair<short, std::string>> attrProps;
-    std::unordered_map<std::string, std::function<void(emscripten::val)>> bubbleEventProps;
-    std::vector<std::pair<short, std::function<void(emscripten::val)>>> nonBubbleEventProps;
-    for (const auto& prop : a_props) {
-        if (prop.first == attr::ATTR_undefined) {
-            continue; // Skip undefined props
-        }
+// Separate props into attributes and event handlers
+void VNodeHandle::addProp(Prop&& a_prop) {
+    if (a_prop.first == attr::ATTR_undefined) {
+        return; // Skip undefined props
+    }
 
-        std::visit([&](auto&& arg) {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, std::string>) {
-                switch (prop.first)
-                {
-                case attr::ATTR_id:
-                    m_pNode->setIdProp(arg);
-                    attrProps.push_back({prop.first, std::move(arg)});
-                    break;
-                case attr::ATTR_key:
-                    m_pNode->setKeyProp(arg);
-                    break;
-                default:
-                    attrProps.push_back({prop.first, std::move(arg)});
-                    break;
-                }
-            } else if constexpr (std::is_same_v<T, std::function<void(emscripten::val)>>) {
-                switch (prop.first)
-                {
-                case attr::ATTR_EVT_onaddelement:
-                    m_pNode->setOnAddElementEvent(std::move(arg));
-                    break;
-                case attr::ATTR_EVT_onbeforemoveelement:
-                    m_pNode->setOnBeforeMoveElementEvent(std::move(arg));
-                    break;
-                case attr::ATTR_EVT_onmoveelement:
-                    m_pNode->setOnMoveElementEvent(std::move(arg));
-                    break;
-                case attr::ATTR_EVT_onremoveelement:
-                    m_pNode->setOnRemoveElementEvent(std::move(arg));
-                    break;
-                default:
-                    auto wrapper = [arg = std::move(arg), runtimeInstance = g_pRenderingEngine](emscripten::val e) {
-                        arg(e); 
-                        runtimeInstance->invalidate();
-                    };
-                    if (prop.first >= attr::ATTR_EVT_NON_BUBBLE_START && prop.first < attr::ATTR_EVT_NON_BUBBLE_END) {
-                        // Non-bubble event  
-                        nonBubbleEventProps.push_back({prop.first, std::move(wrapper)});
+    short nId = a_prop.first;
+    std::visit([&](auto&& arg) {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+            switch (nId)
+            {
+            case attr::ATTR_id:
+                m_pNode->setIdProp(arg);
+                m_pNode->getProps().push_back({nId, std::move(arg)});
+                break;
+            case attr::ATTR_key:
+                m_pNode->setKeyProp(arg);
+                break;
+            case attr::ATTR_classtoken:
+                addProp(Prop(nId, attr::SharedText(std::move(arg))));
+                break;
+            default:
+                m_pNode->getProps().push_back({nId, std::move(arg)});
+                break;
+            }
+        } else if constexpr (std::is_same_v<T, EventHandler>) {
+            switch (nId)
+            {
+            case attr::ATTR_EVT_onaddelement:
+                m_pNode->setOnAddElementEvent(std::move(arg));
+                break;
+            case attr::ATTR_EVT_onbeforemoveelement:
+                m_pNode->setOnBeforeMoveElementEvent(std::move(arg));
+                break;
+            case attr::ATTR_EVT_onmoveelement:
+                m_pNode->setOnMoveElementEvent(std::move(arg));
+                break;
+            case attr::ATTR_EVT_onremoveelement:
+                m_pNode->setOnRemoveElementEvent(std::move(arg));
+                break;
+            default:
+                // Stored as is, EventBridge invalidates the engine after dispatching
+                if (nId >= attr::ATTR_EVT_NON_BUBBLE_START && nId < attr::ATTR_EVT_NON_BUBBLE_END) {
+                    // Non-bubble event  
+                    m_pNode->getNonBubbleEvents().push_back({nId, std::move(arg)});
+                } else {
+                    // Bubble event, a later handler for the same event replaces the earlier one
+                    auto& bubbleEvents = m_pNode->getBubbleEvents();
+                    auto it = std::find_if(bubbleEvents.begin(), bubbleEvents.end(),
+                        [nId](const auto& a_event) { return a_event.first == nId; });
+                    if (it != bubbleEvents.end()) {
+                        it->second = std::move(arg);
                     } else {
-                        // Bubble event
-                        bubbleEventProps[attr::attrIdToName(prop.first)] = std::move(wrapper);
+                        bubbleEvents.push_back({nId, std::move(arg)});
                     }
-                    break;
                 }
+                break;
             }
-        }, prop.second);
-    }
-    m_pNode->setProps(std::move(attrProps));
-    m_pNode->setBubbleEvents(std::move(bubbleEventProps));
-    m_pNode->setNonBubbleEvents(std::move(nonBubbleEventProps));
-
-    // Extract child VNode pointers
-    std::vector<VNode*> children;
-    children.reserve(a_children.size());
-    for (size_t i = 0; i < a_children.size(); ++i) {
-        VNode* pChildNode = a_children[i].m_pNode;
-        if (pChildNode->isFragment()) {
-            // Flatten away inner fragments
-            for (VNode* pGrandChild : pChildNode->getChildren()) {
-                pGrandChild->setStableKeyPrefix(
-                    IdManager::concatIds(
-                        IdManager::concatIds(
-                            pChildNode->getStableKeyPrefix(), 
-                            pChildNode->getId()), 
-                        pGrandChild->getStableKeyPrefix()));
-                pGrandChild->setParent(m_pNode);
-                children.push_back(pGrandChild);
+        } else if constexpr (std::is_same_v<T, attr::StyleProp>) {
+            m_pNode->getStyleProps().push_back(std::move(arg));
+        } else if constexpr (std::is_same_v<T, attr::SharedText>) {
+            if (!arg.empty()) { // Class token, classList rejects empty ones
+                m_pNode->getClassTokens().push_back(std::move(arg));
+            }
+        } else if constexpr (std::is_same_v<T, attr::AnimatedProp>) {
+            m_pNode->getAnimatedProps().push_back(std::move(arg));
+        } else if constexpr (std::is_same_v<T, String>) {
+            switch (nId)
+            {
+            case attr::ATTR_id:
+            case attr::ATTR_key:
+            case attr::ATTR_classtoken:
+                addProp(Prop(nId, arg.std_str())); // Needed in wasm for ids and keys
+                break;
+            default:
+                m_pNode->getJsProps().push_back({nId, arg.toVal()});
+                break;
             }
         }
-        else {
-            pChildNode->setParent(m_pNode);
-            children.push_back(pChildNode);
+    }, std::move(a_prop.second));
+}
+
+void VNodeHandle::addChild(const VNodeHandle& a_child) {
+    VNode* pChildNode = a_child.m_pNode;
+    if (pChildNode->isFragment()) {
+        // Flatten away inner fragments. The grandchildren keep the fragment's id as a key prefix:
+        // they point at the fragment, which points at where it was flattened into, and so on.
+        // No strings are built here, the IdManager walks the chain when it needs the key.
+        pChildNode->setFlattenedInto(m_pNode);
+        for (VNode* pGrandChild : pChildNode->getChildren()) {
+            if (pGrandChild->getPrefixFragment() == nullptr) {
+                pGrandChild->setPrefixFragment(pChildNode); // Lifted before: the chain already reaches this fragment
+            }
+            pGrandChild->setParent(m_pNode);
+            m_pNode->getChildren().push_back(pGrandChild);
         }
     }
-    m_pNode->setChildren(std::move(children));
+    else {
+        pChildNode->setParent(m_pNode);
+        m_pNode->getChildren().push_back(pChildNode);
+    }
+}
+
+void VNodeHandle::addChild(const std::vector<VNodeHandle>& a_children) {
+    // Children built by loop() / map()
+    m_pNode->getChildren().reserve(m_pNode->getChildren().size() + a_children.size());
+    for (const VNodeHandle& child : a_children) {
+        addChild(child);
+    }
+}
+
+void VNodeHandle::endNode() {
+    m_pNode->finishProps();
 }
 
 VNodeHandle::VNodeHandle(std::string a_sTextContent) {
+    VOLT_PROFILE_SCOPE(buildMs);
     m_pNode = g_pRenderingEngine->recycleVNode();
     
     m_pNode->setAsText(a_sTextContent);
 }
 
 VNodeHandle::VNodeHandle(const char * a_sTextContent) {
+    VOLT_PROFILE_SCOPE(buildMs);
     m_pNode = g_pRenderingEngine->recycleVNode();
 
     m_pNode->setAsText(std::string(a_sTextContent));
 }
 
-VNodeHandle VNodeHandle::track(int a_nStableKeyPosition) const { 
-    m_pNode->setStableKeyPosition(a_nStableKeyPosition); 
+VNodeHandle::VNodeHandle(const String& a_sTextContent) {
+    VOLT_PROFILE_SCOPE(buildMs);
+    m_pNode = g_pRenderingEngine->recycleVNode();
+
+    m_pNode->setAsText(a_sTextContent);
+}
+
+VNodeHandle::VNodeHandle(const Format& a_format) {
+    VOLT_PROFILE_SCOPE(buildMs);
+    m_pNode = g_pRenderingEngine->recycleVNode();
+
+    m_pNode->setAsText(a_format);
+}
+
+VNodeHandle VNodeHandle::track(StableKey a_stableKey) const { 
+    m_pNode->setStableKey(a_stableKey); 
     return *this;
 }
 
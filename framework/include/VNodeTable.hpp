@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+// Low bits of a VNodeId index the slot, the rest count its reuses.
+// 22 bits allow 4M live VNodes across all engines and 1024 reuses of a slot
+// before a stale handle could match again.
+#ifndef VOLT_NODE_INDEX_BITS
+#define VOLT_NODE_INDEX_BITS 22
+#endif
+
+namespace volt {
+
+class VNode;
+
+// 32-bit handle of a pooled VNode, 0 is never a valid node
+using VNodeId = uint32_t;
+
+// ============================================================================
+// VNodeTable - Module wide slots of pooled VNodes, addressed by VNodeId
+// ============================================================================
+// DOM elements refer back to their VNode through a VNodeId (__volt_node)
+// instead of a raw pointer: a 32-bit number stays a small integer in JS,
+// where a MEMORY64 pointer crosses as a BigInt, and the generation bits make
+// a handle of a recycled or freed VNode resolve to nullptr instead of to
+// whatever node now lives at that address.
+// Only the back-reference goes through the table: the tree (children,
+// parents, IdManager stores) still links VNodes by pointer.
+
+class VNodeTable {
+public:
+    // Module wide instance, shared by all engines on this thread
+    static VNodeTable& 
+                instance                    ();
+
+    // Slot for a new pooled VNode
+    VNodeId     add                         (VNode* a_pNode);
+
+    // Same slot under a new generation, handles to the previous use go stale
+    VNodeId     renew                       (VNodeId a_nId);
+
+    // Frees the slot, the handle and every older one go stale
+    void        remove                      (VNodeId a_nId);
+
+    // VNode of a handle, nullptr if the handle is stale or invalid
+    VNode*      find                        (VNodeId a_nId) const {
+        uint32_t nIndex = a_nId & INDEX_MASK;
+        if (nIndex == 0 || nIndex >= m_slots.size() || m_slots[nIndex].nId != a_nId) {
+            return nullptr;
+        }
+        return m_slots[nIndex].pNode;
+    }
+
+    size_t      size                        () const { return m_slots.size() - 1 - m_freeSlots.size(); }
+
+private:
+    static constexpr uint32_t INDEX_MASK = (1u << VOLT_NODE_INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_STEP = 1u << VOLT_NODE_INDEX_BITS;
+
+    struct Slot {
+        VNode*      pNode;
+        VNodeId     nId; // Current handle of the slot: index | generation
+    };
+
+    VNodeTable() : m_slots(1, Slot{nullptr, 0}) {} // Slot 0 reserved, so 0 stays invalid
+
+    // MEMBERS
+    std::vector<Slot>
+                m_slots;
+    std::vector<uint32_t>
+                m_freeSlots;
+};
+
+} // namespace volt
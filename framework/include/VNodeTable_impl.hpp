@@ -0,0 +1,53 @@
+#include "VNodeTable.hpp"
+#include <emscripten.h>
+
+namespace volt {
+
+// ============================================================================
+// VNodeTable
+// ============================================================================
+
+VNodeTable& VNodeTable::instance() {
+    thread_local VNodeTable s_table;
+    return s_table;
+}
+
+VNodeId VNodeTable::add(VNode* a_pNode) {
+    uint32_t nIndex;
+    if (!m_freeSlots.empty()) {
+        nIndex = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        if (m_slots.size() > INDEX_MASK) {
+            emscripten_log(EM_LOG_ERROR, "Volt: more than %u live VNodes, raise VOLT_NODE_INDEX_BITS", INDEX_MASK);
+            return 0;
+        }
+        nIndex = static_cast<uint32_t>(m_slots.size());
+        m_slots.push_back({nullptr, nIndex});
+    }
+    m_slots[nIndex].pNode = a_pNode;
+    return m_slots[nIndex].nId;
+}
+
+VNodeId VNodeTable::renew(VNodeId a_nId) {
+    uint32_t nIndex = a_nId & INDEX_MASK;
+    if (find(a_nId) == nullptr) {
+        return a_nId;
+    }
+    Slot& slot = m_slots[nIndex];
+    slot.nId += GENERATION_STEP; // Only the generation bits change, they wrap around
+    return slot.nId;
+}
+
+void VNodeTable::remove(VNodeId a_nId) {
+    uint32_t nIndex = a_nId & INDEX_MASK;
+    if (find(a_nId) == nullptr) {
+        return;
+    }
+    Slot& slot = m_slots[nIndex];
+    slot.pNode = nullptr;
+    slot.nId += GENERATION_STEP;
+    m_freeSlots.push_back(nIndex);
+}
+
+} // namespace volt
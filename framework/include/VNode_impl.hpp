@@ -13,45 +13,102 @@ void VNode::reuse(tag::ETag a_nTag) {
     //log("VNode::reuse tag " + std::string(tag::tagToString(m_nTag)) + " -> " + std::string(tag::tagToString(a_nTag)));
     m_nTag = a_nTag;
     m_props.clear();
+    m_jsProps.clear();
+    m_styleProps.clear();
+    m_classTokens.clear();
+    m_animatedProps.clear();
     m_sIdProp.clear();
     m_sKeyProp.clear();
     m_bubbleEvents.clear();
-    m_onAddElementEvent = [](emscripten::val){};
-    m_onBeforeMoveElementEvent = [](emscripten::val){};
-    m_onMoveElementEvent = [](emscripten::val){};
-    m_onRemoveElementEvent = [](emscripten::val){};
+    m_onAddElementEvent = nullptr;
+    m_onBeforeMoveElementEvent = nullptr;
+    m_onMoveElementEvent = nullptr;
+    m_onRemoveElementEvent = nullptr;
     m_nonBubbleEvents.clear();
-    m_nonBubbleEventsByName.clear();
     m_children.clear();
-    m_sStableKeyPrefix.clear();
-    m_nStableKeyPosition = -1;
+    m_stableKey = StableKey();
     m_matchingElement = emscripten::val::undefined();
     m_pParent = nullptr;
+    m_pPrefixFragment = nullptr;
+    m_pFlattenedInto = nullptr;
+    m_bFocusWithin = false;
+    m_bFormattedText = false;
+    m_nFormattedEpoch = 0;
+    m_jsText = emscripten::val::undefined();
 }
 
 void VNode::setProps(std::vector<std::pair<short, std::string>> a_props) {
     m_props = std::move(a_props);
-    
+    sortProps();
+}
+
+void VNode::sortProps() {
     // Sort props by attribute ID for efficient diffing
     std::sort(m_props.begin(), m_props.end(), 
         [](const auto& a_a, const auto& a_b) { return a_a.first < a_b.first; });
 }
 
-void VNode::setBubbleEvents(std::unordered_map<std::string, std::function<void(emscripten::val)>> a_events) {
+void VNode::setStyleProps(std::vector<attr::StyleProp> a_styleProps) {
+    m_styleProps = std::move(a_styleProps);
+    sortStyleProps();
+}
+
+void VNode::sortStyleProps() {
+    // Sort by property for efficient diffing, on duplicates the last one wins
+    std::stable_sort(m_styleProps.begin(), m_styleProps.end(),
+        [](const auto& a_a, const auto& a_b) { return a_a.property.compare(a_b.property) < 0; });
+    auto itEnd = m_styleProps.begin();
+    for (auto it = m_styleProps.begin(); it != m_styleProps.end(); ++it) {
+        if (itEnd != m_styleProps.begin() && (itEnd - 1)->property == it->property) {
+            *(itEnd - 1) = std::move(*it);
+        } else {
+            if (itEnd != it) {
+                *itEnd = std::move(*it);
+            }
+            ++itEnd;
+        }
+    }
+    m_styleProps.erase(itEnd, m_styleProps.end());
+}
+
+void VNode::setClassTokens(std::vector<attr::SharedText> a_classTokens) {
+    m_classTokens = std::move(a_classTokens);
+    sortClassTokens();
+}
+
+void VNode::sortClassTokens() {
+    // Sort and dedupe for efficient diffing
+    std::sort(m_classTokens.begin(), m_classTokens.end(),
+        [](const auto& a_a, const auto& a_b) { return a_a.compare(a_b) < 0; });
+    m_classTokens.erase(std::unique(m_classTokens.begin(), m_classTokens.end()), m_classTokens.end());
+}
+
+void VNode::setBubbleEvents(std::vector<std::pair<short, EventHandler>> a_events) {
     m_bubbleEvents = std::move(a_events);
 }
 
-void VNode::setNonBubbleEvents(std::vector<std::pair<short, std::function<void(emscripten::val)>>> a_events) {
+void VNode::setNonBubbleEvents(std::vector<std::pair<short, EventHandler>> a_events) {
     m_nonBubbleEvents = std::move(a_events);
+    sortNonBubbleEvents();
+}
 
+void VNode::sortNonBubbleEvents() {
     // Sort non-bubble events by attribute ID for efficient diffing
     std::sort(m_nonBubbleEvents.begin(), m_nonBubbleEvents.end(), 
         [](const auto& a_a, const auto& a_b) { return a_a.first < a_b.first; });
+}
 
-    m_nonBubbleEventsByName.clear();
-    for (const auto& eventPair : m_nonBubbleEvents) {
-        m_nonBubbleEventsByName[attr::attrIdToName(eventPair.first)] = eventPair.second;
-    }
+void VNode::sortJsProps() {
+    std::sort(m_jsProps.begin(), m_jsProps.end(),
+        [](const auto& a_a, const auto& a_b) { return a_a.first < a_b.first; });
+}
+
+void VNode::finishProps() {
+    sortProps();
+    sortJsProps();
+    sortStyleProps();
+    sortClassTokens();
+    sortNonBubbleEvents();
 }
 
 void VNode::setChildren(std::vector<VNode*> a_children) {
@@ -63,14 +120,127 @@ void VNode::setAsText(std::string a_sTextContent) {
     m_props.push_back({attr::ATTR_nodevalue, std::move(a_sTextContent)});
 }
 
+void VNode::setAsText(const Format& a_format) {
+    reuse(tag::ETag::_TEXT);
+    m_textFormat = a_format;
+    m_bFormattedText = true;
+}
+
+void VNode::setAsText(const String& a_sTextContent) {
+    reuse(tag::ETag::_TEXT);
+    m_jsText = a_sTextContent.toVal();
+}
+
 // Get text content (only valid for TEXT nodes)
-std::string VNode::getText() const {
+std::string_view VNode::getText() const {
+    if (isJsText()) {
+        // Decoded for verify and markup only, the diff compares the handles
+        TextArena& arena = TextArena::instance();
+        if (m_nFormattedEpoch != arena.getEpoch()) {
+            m_sFormattedText = arena.write(m_jsText.as<std::string>());
+            m_nFormattedEpoch = arena.getEpoch();
+        }
+        return m_sFormattedText;
+    }
+    if (m_bFormattedText) {
+        TextArena& arena = TextArena::instance();
+        if (m_nFormattedEpoch != arena.getEpoch()) {
+            m_sFormattedText = arena.write(m_textFormat);
+            m_nFormattedEpoch = arena.getEpoch();
+        }
+        return m_sFormattedText;
+    }
     if (isText() && !m_props.empty() && m_props[0].first == attr::ATTR_nodevalue) {
         return m_props[0].second;
     }
     return "";
 }
 
+// Text escapes & < >, attribute values (double quoted) also "
+static void appendEscapedHtml(std::string& a_sHtml, std::string_view a_sText, bool a_bAttribute) {
+    for (char cChar : a_sText) {
+        switch (cChar) {
+            case '&': a_sHtml += "&amp;"; break;
+            case '<': a_sHtml += "&lt;"; break;
+            case '>': a_sHtml += "&gt;"; break;
+            case '"': a_sHtml += a_bAttribute ? "&quot;" : "\""; break;
+            default:  a_sHtml += cChar; break;
+        }
+    }
+}
+
+// Elements without a closing tag
+static bool isVoidTag(tag::ETag a_nTag) {
+    switch (a_nTag) {
+        case tag::ETag::area: case tag::ETag::base: case tag::ETag::br: case tag::ETag::col:
+        case tag::ETag::embed: case tag::ETag::hr: case tag::ETag::img: case tag::ETag::input:
+        case tag::ETag::link: case tag::ETag::meta: case tag::ETag::param: case tag::ETag::source:
+        case tag::ETag::track: case tag::ETag::wbr:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void VNode::appendHtml(std::string& a_sHtml) const {
+    if (isText()) {
+        appendEscapedHtml(a_sHtml, getText(), false);
+        return;
+    }
+    if (!isFragment()) {
+        const char* sTagName = tag::tagToString(m_nTag);
+        a_sHtml += '<';
+        a_sHtml += sTagName;
+        for (const auto& [attrId, value] : m_props) {
+            a_sHtml += ' ';
+            a_sHtml += attr::attrIdToName(attrId);
+            a_sHtml += "=\"";
+            appendEscapedHtml(a_sHtml, value, true);
+            a_sHtml += '"';
+        }
+        for (const auto& [attrId, hValue] : m_jsProps) {
+            a_sHtml += ' ';
+            a_sHtml += attr::attrIdToName(attrId);
+            a_sHtml += "=\"";
+            appendEscapedHtml(a_sHtml, hValue.as<std::string>(), true);
+            a_sHtml += '"';
+        }
+        if (!m_classTokens.empty()) {
+            a_sHtml += " class=\"";
+            for (size_t i = 0; i < m_classTokens.size(); ++i) {
+                if (i > 0) {
+                    a_sHtml += ' ';
+                }
+                appendEscapedHtml(a_sHtml, m_classTokens[i].view(), true);
+            }
+            a_sHtml += '"';
+        }
+        if (!m_styleProps.empty()) {
+            a_sHtml += " style=\"";
+            for (const attr::StyleProp& styleProp : m_styleProps) {
+                appendEscapedHtml(a_sHtml, styleProp.property.view(), true);
+                a_sHtml += ": ";
+                appendEscapedHtml(a_sHtml, styleProp.value.view(), true);
+                a_sHtml += "; ";
+            }
+            a_sHtml.pop_back();
+            a_sHtml += '"';
+        }
+        a_sHtml += '>';
+        if (isVoidTag(m_nTag)) {
+            return;
+        }
+    }
+    for (const VNode* pChild : m_children) {
+        pChild->appendHtml(a_sHtml);
+    }
+    if (!isFragment()) {
+        a_sHtml += "</";
+        a_sHtml += tag::tagToString(m_nTag);
+        a_sHtml += '>';
+    }
+}
+
 // ============================================================================
 // Helpers
 // ============================================================================
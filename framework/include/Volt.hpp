@@ -15,14 +15,24 @@
 #endif
 
 #include "VoltLog.hpp"
+#include "VoltProfiler.hpp"
+#include "VoltSpan.hpp"
+#include "VoltPatch.hpp"
 #include "VoltConfig.hpp"
 #include "DOM.hpp"
 #include "IRuntime.hpp"
 #include "EventBridge.hpp"
 #include "App.hpp"
 #include "VoltEngine.hpp"
+#include "VoltTask.hpp"
+#include "VoltScheduler.hpp"
+#include "VoltAnimated.hpp"
 #include "RenderingEngine.hpp"
+#include "InplaceFunction.hpp"
+#include "StableKey.hpp"
+#include "VoltFormat.hpp"
 #include "Attrs.hpp"
+#include "VNodeTable.hpp"
 #include "VNode.hpp"
 #include "VoltDiffPatch.hpp"
 #include "IdManager.hpp"
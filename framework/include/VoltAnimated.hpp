@@ -0,0 +1,145 @@
+#pragma once
+
+#include <emscripten/val.h>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <type_traits>
+#include "Attrs.hpp"
+#include "VNodeTable.hpp"
+
+// Longest time step of a spring, a frame after a long pause doesn't overshoot
+#ifndef VOLT_SPRING_MAX_STEP_MS
+#define VOLT_SPRING_MAX_STEP_MS 64.0
+#endif
+
+namespace volt {
+
+// ============================================================================
+// Animated - A number interpolated outside of render
+// ============================================================================
+// Bound to a CSS property or attribute with attr::animate_style() / animate_attr():
+//
+//   class Drawer : public volt::App {
+//       volt::Animated<double> m_offset{-320};
+//       ...
+//       VNodeHandle render() override {
+//           return tag::nav({
+//               attr::animate_style("transform", m_offset, "translateX(", "px)"),
+//               attr::onclick([this](emscripten::val) { m_offset.springTo(0); }),
+//           }, ...);
+//       }
+//   };
+//
+// While it moves, the VoltScheduler steps it once per animation frame and
+// writes the bound properties of the elements built with it, nothing renders.
+// The diff only (un)binds elements as they are added, synced and removed.
+// Destroyed while bound, the nodes drop it: the diff skips it and clears
+// the property once a render no longer binds it.
+
+enum class EEasing {
+    LINEAR,
+    EASE_IN,
+    EASE_OUT,
+    EASE_IN_OUT,
+};
+
+// Damped spring, defaults settle in about half a second without visible bounce
+struct Spring {
+    double nStiffness = 170.0;
+    double nDamping = 26.0;
+    double nMass = 1.0;
+    double nRestDelta = 0.01; // At rest once both distance and speed are below this
+};
+
+// Untyped part, bound to VNodes and stepped by the VoltScheduler
+class AnimatedBase {
+public:
+    AnimatedBase(const AnimatedBase&) = delete;
+    AnimatedBase& operator=(const AnimatedBase&) = delete;
+    ~AnimatedBase();
+
+    double getValue() const { return m_nValue; }
+    double getTarget() const { return m_nTarget; }
+    bool isAnimating() const { return m_nMode != EMode::NONE; }
+
+    // Bindings, kept by VoltDiffPatch. A VNode is bound once however many props it has for this value.
+    void bind(VNodeId a_nNode);
+    void unbind(VNodeId a_nNode);
+    void rebind(VNodeId a_nOldNode, VNodeId a_nNewNode);
+
+    // Any element bound to any Animated, removals skip the subtree walk otherwise
+    static bool hasBindings() { return s_nBindings > 0; }
+
+    // Write the current value to one bound property of an element / remove it again
+    void writeTo(emscripten::val a_hElement, const attr::AnimatedProp& a_prop) const;
+    static void clearFrom(emscripten::val a_hElement, const attr::AnimatedProp& a_prop);
+
+    // Advance to a_nNowMs and write every bound property, false once settled.
+    // Called by the VoltScheduler in each animation frame.
+    bool step(double a_nNowMs);
+
+protected:
+    AnimatedBase(double a_nValue, bool a_bIntegral) : m_nValue(a_nValue), m_nTarget(a_nValue), m_bIntegral(a_bIntegral) {}
+
+    void jumpTo(double a_nValue);
+    void tweenTo(double a_nTarget, double a_nDurationMs, EEasing a_nEasing);
+    void springTo(double a_nTarget, const Spring& a_spring);
+
+private:
+    enum class EMode { NONE, TWEEN, SPRING };
+
+    void start();
+    void writeBound();
+
+    static double ease(EEasing a_nEasing, double a_nT);
+
+    std::vector<VNodeId> m_nodes;
+    double m_nValue;
+    double m_nTarget;
+    double m_nVelocity = 0;     // Units per second, SPRING only
+    double m_nFrom = 0;         // TWEEN only
+    double m_nStartMs = 0;      // TWEEN: start time, SPRING: time of the last step
+    double m_nDurationMs = 0;
+    EEasing m_nEasing = EEasing::LINEAR;
+    Spring m_spring;
+    EMode m_nMode = EMode::NONE;
+    bool m_bIntegral;
+    bool m_bStarted = false;    // Queued in the VoltScheduler
+
+    static thread_local size_t s_nBindings;
+};
+
+template<typename T>
+class Animated : public AnimatedBase {
+    static_assert(std::is_arithmetic_v<T>, "Animated<T> needs a number type");
+public:
+    explicit Animated(T a_value = T{}) : AnimatedBase(static_cast<double>(a_value), std::is_integral_v<T>) {}
+
+    T get() const { return cast(getValue()); }
+    T target() const { return cast(getTarget()); }
+
+    // Jump there, written in the next frame
+    void set(T a_value) { jumpTo(static_cast<double>(a_value)); }
+
+    // From the current value, over a fixed time
+    void tweenTo(T a_target, double a_nDurationMs, EEasing a_nEasing = EEasing::EASE_OUT) {
+        AnimatedBase::tweenTo(static_cast<double>(a_target), a_nDurationMs, a_nEasing);
+    }
+
+    // From the current value and speed, retargeting keeps the motion continuous
+    void springTo(T a_target, const Spring& a_spring = Spring()) {
+        AnimatedBase::springTo(static_cast<double>(a_target), a_spring);
+    }
+
+private:
+    static T cast(double a_nValue) {
+        if constexpr (std::is_integral_v<T>) {
+            return static_cast<T>(std::lround(a_nValue));
+        } else {
+            return static_cast<T>(a_nValue);
+        }
+    }
+};
+
+} // namespace volt
@@ -0,0 +1,195 @@
+#include "VoltAnimated.hpp"
+#include <algorithm>
+#include <charconv>
+
+namespace volt {
+
+// ============================================================================
+// AnimatedBase Implementation
+// ============================================================================
+
+thread_local size_t AnimatedBase::s_nBindings = 0;
+
+AnimatedBase::~AnimatedBase() {
+    if (m_bStarted) {
+        VoltScheduler::instance().stopAnimation(this);
+    }
+    // Nodes still rendered with it drop the pointer, the diff skips null bindings
+    for (VNodeId nNode : m_nodes) {
+        VNode* pNode = VNodeTable::instance().find(nNode);
+        if (pNode == nullptr) {
+            continue;
+        }
+        for (attr::AnimatedProp& prop : pNode->getAnimatedProps()) {
+            if (prop.pAnimated == this) {
+                prop.pAnimated = nullptr;
+            }
+        }
+    }
+    s_nBindings -= m_nodes.size();
+}
+
+void AnimatedBase::bind(VNodeId a_nNode) {
+    if (std::find(m_nodes.begin(), m_nodes.end(), a_nNode) == m_nodes.end()) {
+        m_nodes.push_back(a_nNode);
+        ++s_nBindings;
+    }
+}
+
+void AnimatedBase::unbind(VNodeId a_nNode) {
+    auto it = std::find(m_nodes.begin(), m_nodes.end(), a_nNode);
+    if (it != m_nodes.end()) {
+        *it = m_nodes.back();
+        m_nodes.pop_back();
+        --s_nBindings;
+    }
+}
+
+void AnimatedBase::rebind(VNodeId a_nOldNode, VNodeId a_nNewNode) {
+    auto it = std::find(m_nodes.begin(), m_nodes.end(), a_nOldNode);
+    if (it != m_nodes.end() && std::find(m_nodes.begin(), m_nodes.end(), a_nNewNode) == m_nodes.end()) {
+        *it = a_nNewNode;
+    } else {
+        unbind(a_nOldNode);
+        bind(a_nNewNode);
+    }
+}
+
+void AnimatedBase::writeTo(emscripten::val a_hElement, const attr::AnimatedProp& a_prop) const {
+    // Fixed point without trailing zeros: "0.5", "120", never "1e-05"
+    char buffer[32];
+    std::to_chars_result result = m_bIntegral
+        ? std::to_chars(buffer, buffer + sizeof(buffer), std::llround(m_nValue))
+        : std::to_chars(buffer, buffer + sizeof(buffer), m_nValue, std::chars_format::fixed, 3);
+    char* pEnd = result.ptr;
+    if (!m_bIntegral) {
+        while (pEnd[-1] == '0') {
+            --pEnd;
+        }
+        if (pEnd[-1] == '.') {
+            --pEnd;
+        }
+    }
+
+    thread_local std::string s_sText;
+    s_sText.assign(a_prop.prefix).append(buffer, pEnd).append(a_prop.suffix);
+
+    if (a_prop.nAttrId == attr::ATTR_styleprop) {
+        dom::setStyleProperty(a_hElement["style"], a_prop.property, s_sText);
+    } else {
+        dom::setAttribute(a_hElement, a_prop.nAttrId, s_sText);
+    }
+}
+
+void AnimatedBase::clearFrom(emscripten::val a_hElement, const attr::AnimatedProp& a_prop) {
+    if (a_prop.nAttrId == attr::ATTR_styleprop) {
+        dom::removeStyleProperty(a_hElement["style"], a_prop.property);
+    } else {
+        dom::removeAttribute(a_hElement, a_prop.nAttrId);
+    }
+}
+
+void AnimatedBase::jumpTo(double a_nValue) {
+    m_nValue = a_nValue;
+    m_nTarget = a_nValue;
+    m_nVelocity = 0;
+    m_nMode = EMode::NONE;
+    start(); // The next frame writes it once
+}
+
+void AnimatedBase::tweenTo(double a_nTarget, double a_nDurationMs, EEasing a_nEasing) {
+    if (a_nDurationMs <= 0) {
+        jumpTo(a_nTarget);
+        return;
+    }
+    m_nFrom = m_nValue;
+    m_nTarget = a_nTarget;
+    m_nVelocity = 0;
+    m_nStartMs = emscripten_get_now();
+    m_nDurationMs = a_nDurationMs;
+    m_nEasing = a_nEasing;
+    m_nMode = EMode::TWEEN;
+    start();
+}
+
+void AnimatedBase::springTo(double a_nTarget, const Spring& a_spring) {
+    m_nTarget = a_nTarget;
+    m_spring = a_spring;
+    if (m_nMode != EMode::SPRING) {
+        m_nStartMs = emscripten_get_now(); // Else the spring keeps its clock and speed
+    }
+    m_nMode = EMode::SPRING;
+    start();
+}
+
+void AnimatedBase::start() {
+    if (!m_bStarted) {
+        m_bStarted = true;
+        VoltScheduler::instance().startAnimation(this);
+    }
+}
+
+bool AnimatedBase::step(double a_nNowMs) {
+    if (m_nMode == EMode::TWEEN) {
+        double nT = std::clamp((a_nNowMs - m_nStartMs) / m_nDurationMs, 0.0, 1.0);
+        m_nValue = m_nFrom + (m_nTarget - m_nFrom) * ease(m_nEasing, nT);
+        if (nT >= 1.0) {
+            m_nValue = m_nTarget;
+            m_nMode = EMode::NONE;
+        }
+    } else if (m_nMode == EMode::SPRING) {
+        // Semi-implicit Euler in steps of at most 1ms, stable for any sane stiffness
+        double nElapsedMs = std::clamp(a_nNowMs - m_nStartMs, 0.0, VOLT_SPRING_MAX_STEP_MS);
+        m_nStartMs = std::max(m_nStartMs, a_nNowMs);
+        int nSteps = std::max(1, static_cast<int>(std::ceil(nElapsedMs)));
+        double nDt = nElapsedMs / 1000.0 / nSteps;
+        for (int i = 0; i < nSteps; ++i) {
+            double nForce = -m_spring.nStiffness * (m_nValue - m_nTarget) - m_spring.nDamping * m_nVelocity;
+            m_nVelocity += nForce / m_spring.nMass * nDt;
+            m_nValue += m_nVelocity * nDt;
+        }
+        if (std::abs(m_nValue - m_nTarget) < m_spring.nRestDelta && std::abs(m_nVelocity) < m_spring.nRestDelta) {
+            m_nValue = m_nTarget;
+            m_nVelocity = 0;
+            m_nMode = EMode::NONE;
+        }
+    }
+
+    writeBound();
+
+    m_bStarted = m_nMode != EMode::NONE;
+    return m_bStarted;
+}
+
+void AnimatedBase::writeBound() {
+    for (size_t i = 0; i < m_nodes.size();) {
+        VNode* pNode = VNodeTable::instance().find(m_nodes[i]);
+        if (pNode == nullptr || pNode->getMatchingElement().isUndefined()) {
+            unbind(m_nodes[i]); // Freed without a removal, e.g. its engine is gone
+            continue;
+        }
+        for (const attr::AnimatedProp& prop : pNode->getAnimatedProps()) {
+            if (prop.pAnimated == this) {
+                writeTo(pNode->getMatchingElement(), prop);
+            }
+        }
+        ++i;
+    }
+}
+
+double AnimatedBase::ease(EEasing a_nEasing, double a_nT) {
+    switch (a_nEasing) {
+        case EEasing::EASE_IN:
+            return a_nT * a_nT * a_nT;
+        case EEasing::EASE_OUT: {
+            double nU = 1.0 - a_nT;
+            return 1.0 - nU * nU * nU;
+        }
+        case EEasing::EASE_IN_OUT:
+            return a_nT < 0.5 ? 4.0 * a_nT * a_nT * a_nT : 1.0 - std::pow(-2.0 * a_nT + 2.0, 3.0) / 2.0;
+        default:
+            return a_nT;
+    }
+}
+
+} // namespace volt
@@ -4,6 +4,7 @@
 #include <emscripten/val.h>
 #include "IdManager.hpp"
 #include "FocusManager.hpp"
+#include "Attrs.hpp"
 
 namespace volt {
 
@@ -13,6 +14,10 @@ class VoltDiffPatch {
 public:
     static void rebuild(IdManager& a_idManager, FocusManager& a_focusManager, VNode* a_pNewVTree, emscripten::val a_hRootContainer);
     static void diffPatch(IdManager& a_idManager, FocusManager& a_focusManager, VNode* a_pPrevVTree, VNode* a_pNewVTree, emscripten::val a_hRootContainer);
+    // Removes the VTree's DOM from the container, detaching listeners and __volt_node back-references
+    static void unmount(VNode* a_pVTree, emscripten::val a_hRootContainer);
+    // Checks that the DOM under the container mirrors the VTree exactly, returns the number of mismatches
+    static int verify(VNode* a_pVTree, emscripten::val a_hRootContainer);
 private:
     static void walk(    
         IdManager& a_idManager, 
@@ -39,15 +44,54 @@ private:
         VNode* a_pOldNode,
         emscripten::val a_hContainer,
         emscripten::val a_hReferenceNode);
+    // Takes a node about to be brought in off the unclaimed set. Returns whether it sits
+    // in a_prevNodes before the walk position: bringing it unlinks it and shifts the rest.
+    static bool claimBroughtNode(
+        std::unordered_set<VNode*>& a_unclaimedOldNodes,
+        const std::vector<VNode*>& a_prevNodes,
+        VNode* a_pOldNode);
     static void addNode(
         IdManager& a_idManager, 
         VNode* a_pNewNode, 
         emscripten::val a_hContainer,
         emscripten::val a_hReferenceNode);
 
+    // volt::String props, after the std::string ones: a prop that became a std::string is not removed
+    static void syncJsProps(
+        emscripten::val a_hElement,
+        const std::vector<std::pair<short, emscripten::val>>& a_oldJsProps,
+        const std::vector<std::pair<short, emscripten::val>>& a_newJsProps,
+        const std::vector<std::pair<short, std::string>>& a_newProps);
+    // Structured style and class, a_pOldNode is nullptr for a new element. After a
+    // style / class attribute write everything is applied again, the write dropped it.
+    static void syncStyleProps(
+        emscripten::val a_hElement,
+        VNode* a_pOldNode,
+        VNode* a_pNewNode);
+    static void syncClassTokens(
+        emscripten::val a_hElement,
+        VNode* a_pOldNode,
+        VNode* a_pNewNode);
+    // Whether syncNodes() writes a_nAttrId on the element (set, update or removal)
+    static bool propChanged(VNode* a_pOldNode, VNode* a_pNewNode, short a_nAttrId);
+    // Binds the element to the Animated values of the new node, a_pOldNode is nullptr for a new element
+    static void syncAnimatedProps(
+        emscripten::val a_hElement,
+        VNode* a_pOldNode,
+        VNode* a_pNewNode);
+    // Removed subtree: its elements stop receiving animation frames
+    static void unbindAnimated(VNode* a_pNode);
+
+    static int verifyChildren(VNode* a_pNode, emscripten::val a_hElement);
+
+    static void detachNode(VNode* a_pNode);
+
     static void transferNode(
         VNode* a_pNewNode, emscripten::val a_hElement);
     static emscripten::val nonBubbleHandler();
+    // Per-element listener of a non-bubble event, skipped for events delegated from the container
+    static void addNonBubbleListener(emscripten::val a_hElement, short a_nEventId);
+    static void removeNonBubbleListener(emscripten::val a_hElement, short a_nEventId);
 };
 
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include "VNode.hpp"
 #include "DOM.hpp"
 #include "VoltLog.hpp"
+#include "VoltProfiler.hpp"
+#include "VoltSpan.hpp"
+#include <cctype>
 
 namespace volt {
 
@@ -53,7 +56,9 @@ void VoltDiffPatch::diffPatch(IdManager& a_idManager, FocusManager& a_focusManag
             "diffPatch(): removing unclaimed node in pending list with tag=" + pUnclaimedNode->getTagName()
         );
 
+        VOLT_PROFILE_COUNT(nodesRemoved);
         pUnclaimedNode->onRemoveElement(pUnclaimedNode->getMatchingElement());
+        unbindAnimated(pUnclaimedNode);
         dom::removeChild(pUnclaimedNode->getParent()->getMatchingElement(), pUnclaimedNode->getMatchingElement());
         pUnclaimedNode->unlink();
     }
@@ -61,6 +66,101 @@ void VoltDiffPatch::diffPatch(IdManager& a_idManager, FocusManager& a_focusManag
     VOLT_LOG_INDENT_POP();
 }
 
+void VoltDiffPatch::unmount(VNode* a_pVTree, emscripten::val a_hRootContainer) {
+    VOLT_INFO("Volt>DiffPatch", "unmount() called: removing the whole tree");
+    VOLT_LOG_INDENT_PUSH();
+
+    // Same as a removal during diffPatch: hooks run for the removed roots only
+    for (VNode* pNode : a_pVTree->getChildren()) {
+        emscripten::val hElement = pNode->getMatchingElement();
+        pNode->onRemoveElement(hElement);
+        unbindAnimated(pNode);
+        detachNode(pNode);
+        dom::removeChild(a_hRootContainer, hElement);
+    }
+
+    VOLT_LOG_INDENT_POP();
+}
+
+void VoltDiffPatch::detachNode(VNode* a_pNode) {
+    emscripten::val hElement = a_pNode->getMatchingElement();
+    if (hElement.isUndefined()) {
+        return;
+    }
+
+    // Element may outlive the engine (held by user JS), it must not point back into freed memory
+    hElement.delete_("__volt_node");
+
+    for (const auto& [eventAttrId, value] : a_pNode->getNonBubbleEvents()) {
+        removeNonBubbleListener(hElement, eventAttrId);
+    }
+
+    for (VNode* pChild : a_pNode->getChildren()) {
+        detachNode(pChild);
+    }
+
+    a_pNode->setMatchingElement(emscripten::val::undefined());
+}
+
+int VoltDiffPatch::verify(VNode* a_pVTree, emscripten::val a_hRootContainer) {
+    VOLT_INFO("Volt>DiffPatch>Verify", "verify() called: comparing VTree against the DOM");
+    VOLT_LOG_INDENT_PUSH();
+
+    int nMismatches = verifyChildren(a_pVTree, a_hRootContainer);
+
+    VOLT_LOG_INDENT_POP();
+    return nMismatches;
+}
+
+int VoltDiffPatch::verifyChildren(VNode* a_pNode, emscripten::val a_hElement) {
+    auto& children = a_pNode->getChildren();
+    int nMismatches = 0;
+
+    int nDomChildren = dom::getChildCount(a_hElement);
+    if (nDomChildren != static_cast<int>(children.size())) {
+        VOLT_ERROR(
+            "Volt>DiffPatch>Verify",
+            "verify(): <" + a_pNode->getTagName() + "> has " + std::to_string(children.size()) +
+            " VNode children but " + std::to_string(nDomChildren) + " DOM children"
+        );
+        emscripten_log(EM_LOG_ERROR, "Volt: verify: child count mismatch under <%s>", a_pNode->getTagName().c_str());
+        return 1; // Positions below are meaningless now
+    }
+
+    for (size_t i = 0; i < children.size(); ++i) {
+        VNode* pChild = children[i];
+        emscripten::val hDomChild = dom::getChildAt(a_hElement, static_cast<int>(i));
+
+        if (pChild->getParent() != a_pNode) {
+            VOLT_ERROR("Volt>DiffPatch>Verify", "verify(): stale parent link at index " + std::to_string(i));
+            ++nMismatches;
+        }
+
+        if (!hDomChild.strictlyEquals(pChild->getMatchingElement()) ||
+            hDomChild["__volt_node"].as<VNodeId>() != pChild->getNodeId()) {
+            VOLT_ERROR(
+                "Volt>DiffPatch>Verify",
+                "verify(): DOM child " + std::to_string(i) + " of <" + a_pNode->getTagName() +
+                "> is not bound to VNode <" + pChild->getTagName() + ">"
+            );
+            emscripten_log(EM_LOG_ERROR, "Volt: verify: element/VNode binding mismatch under <%s>", a_pNode->getTagName().c_str());
+            ++nMismatches;
+            continue;
+        }
+
+        if (pChild->isText()) {
+            if (hDomChild["nodeValue"].as<std::string>() != pChild->getText()) {
+                VOLT_ERROR("Volt>DiffPatch>Verify", "verify(): text mismatch, expected '" + std::string(pChild->getText()) + "'");
+                ++nMismatches;
+            }
+        } else {
+            nMismatches += verifyChildren(pChild, hDomChild);
+        }
+    }
+
+    return nMismatches;
+}
+
 // ASSUMPTION!
 void VoltDiffPatch::walk(
     IdManager& a_idManager, 
@@ -112,7 +212,7 @@ void VoltDiffPatch::walk(
             ++newIdx;
         } else {
             a_idManager.pushVNodeToken(pNewNode);
-            std::string sId = a_idManager.build();
+            const std::string& sId = a_idManager.build();
 
             VOLT_TRACE(
                 "Volt>DiffPatch",
@@ -126,18 +226,20 @@ void VoltDiffPatch::walk(
                     "Volt>DiffPatch",
                     "walk(): identity match at same index → syncNodes (reuse in place)"
                 );
+                VOLT_PROFILE_COUNT(nodesReused);
                 syncNodes(a_idManager, a_focusManager, a_unclaimedOldNodes, pNewNode, pOldNode);
                 a_idManager.addVNode(sId, pNewNode);
                 ++newIdx;
                 ++prevIdx;
             } else if (
-                a_focusManager.isFocused(pPrevNode->getMatchingElement()) && 
+                pPrevNode->hasFocusWithin() && 
                 pOldNode != nullptr) { 
                     // Matches node somewhere else, but prev-node has focus, bring matching element in, it will cause a move
                 VOLT_DEBUG(
                     "Volt>DiffPatch",
                     "walk(): identity match, prev-node has focus → bringAndSyncNodes (DOM move)"
                 );
+                bool bShiftsPrev = claimBroughtNode(a_unclaimedOldNodes, a_prevNodes, pOldNode);
                 bringAndSyncNodes(
                     a_idManager,
                     a_focusManager,
@@ -147,6 +249,9 @@ void VoltDiffPatch::walk(
                     a_hContainer,
                     pPrevNode->getMatchingElement()
                 );
+                if (bShiftsPrev) {
+                    --prevIdx;
+                }
                 a_idManager.addVNode(sId, pNewNode);
                 ++newIdx;
             } else if (
@@ -163,8 +268,14 @@ void VoltDiffPatch::walk(
                 do {
                     a_unclaimedOldNodes.insert(a_prevNodes[prevIdx]);
                     ++prevIdx;
-                } while (a_prevNodes[prevIdx] != pOldNode); // ASSUMPTION! There is a matching node later on
+                } while (prevIdx < a_prevNodes.size() && a_prevNodes[prevIdx] != pOldNode); // ASSUMPTION! There is a matching node later on
+                if (prevIdx == a_prevNodes.size()) {
+                    VOLT_ERROR("Volt>DiffPatch", "walk(): linked sibling not found after prevIdx, stable ids out of sync");
+                    a_idManager.popToken();
+                    break;
+                }
                 // Now prev-node == pOldNode <matching> pNewNode
+                VOLT_PROFILE_COUNT(nodesReused);
                 syncNodes(a_idManager, a_focusManager, a_unclaimedOldNodes, pNewNode, pOldNode);
                 a_idManager.addVNode(sId, pNewNode);
                 ++newIdx;
@@ -175,9 +286,7 @@ void VoltDiffPatch::walk(
                     "walk(): identity match at different index → bringAndSyncNodes (DOM move)"
                 );
                 // Remove from unclaimed set if present as it is being reused now
-                if (a_unclaimedOldNodes.count(pOldNode) > 0) { 
-                    a_unclaimedOldNodes.erase(pOldNode);
-                }
+                bool bShiftsPrev = claimBroughtNode(a_unclaimedOldNodes, a_prevNodes, pOldNode);
                 bringAndSyncNodes(
                     a_idManager,
                     a_focusManager,
@@ -187,6 +296,9 @@ void VoltDiffPatch::walk(
                     a_hContainer,
                     pPrevNode->getMatchingElement()
                 );
+                if (bShiftsPrev) {
+                    --prevIdx;
+                }
                 a_idManager.addVNode(sId, pNewNode);
                 ++newIdx;
             } else { // New node, no match, add it
@@ -216,21 +328,55 @@ void VoltDiffPatch::walk(
             " tag=" + pPrevNode->getTagName()
         );
 
+        VOLT_PROFILE_COUNT(nodesRemoved);
         pPrevNode->onRemoveElement(pPrevNode->getMatchingElement());
+        unbindAnimated(pPrevNode);
         dom::removeChild(a_hContainer, pPrevNode->getMatchingElement());
         pPrevNode->unlink();
         // size() is already decremented by unlink()
     }
 
-    // Add any remaining new nodes, this sets the new element handle
+    // Add any remaining new nodes, this sets the new element handle. Prev nodes unlinked
+    // above (a reordered list's tail) are still matched by identity and brought in.
     while (newIdx < a_newNodes.size()) {
         VNode* pNewNode = a_newNodes[newIdx];
-        VOLT_DEBUG(
-            "Volt>DiffPatch",
-            "walk(): addNode for remaining new node at index=" + std::to_string(newIdx) +
-            " tag=" + pNewNode->getTagName()
-        );
-        addNode(a_idManager, pNewNode, a_hContainer, emscripten::val::undefined());
+        VNode* pOldNode = nullptr;
+        const std::string* pId = nullptr;
+        if (!pNewNode->isText()) {
+            a_idManager.pushVNodeToken(pNewNode);
+            pId = &a_idManager.build();
+            pOldNode = a_idManager.findVNode(*pId);
+        }
+
+        if (pOldNode != nullptr) {
+            VOLT_DEBUG(
+                "Volt>DiffPatch",
+                "walk(): identity match for remaining new node at index=" + std::to_string(newIdx) +
+                " → bringAndSyncNodes (DOM move)"
+            );
+            claimBroughtNode(a_unclaimedOldNodes, a_prevNodes, pOldNode);
+            bringAndSyncNodes(
+                a_idManager,
+                a_focusManager,
+                a_unclaimedOldNodes,
+                pNewNode,
+                pOldNode,
+                a_hContainer,
+                emscripten::val::undefined()
+            );
+            a_idManager.addVNode(*pId, pNewNode);
+            a_idManager.popToken();
+        } else {
+            VOLT_DEBUG(
+                "Volt>DiffPatch",
+                "walk(): addNode for remaining new node at index=" + std::to_string(newIdx) +
+                " tag=" + pNewNode->getTagName()
+            );
+            if (!pNewNode->isText()) {
+                a_idManager.popToken();
+            }
+            addNode(a_idManager, pNewNode, a_hContainer, emscripten::val::undefined());
+        }
         ++newIdx;
     }
 
@@ -246,20 +392,35 @@ void VoltDiffPatch::syncTextNodes(
     VOLT_TRACE("Volt>DiffPatch", "syncTextNodes(): entering");
     VOLT_LOG_INDENT_PUSH();
 
+    VOLT_PROFILE_COUNT(nodesReused);
+    VOLT_SPAN_NODE_VISITED();
+
     emscripten::val hElement = a_pPrevNode->getMatchingElement();
 
-    if (a_pNewNode->getText() != a_pPrevNode->getText()) {
+    // Formatted text compares the raw values, it is only formatted when it changed.
+    // JS text compares the handles, then with ===, it is never decoded.
+    bool bChanged = true;
+    if (a_pNewNode->isFormattedText() && a_pPrevNode->isFormattedText()) {
+        bChanged = !(a_pNewNode->getTextFormat() == a_pPrevNode->getTextFormat());
+    } else if (a_pNewNode->isJsText() && a_pPrevNode->isJsText()) {
+        const emscripten::val& hNewText = a_pNewNode->getJsText();
+        const emscripten::val& hPrevText = a_pPrevNode->getJsText();
+        bChanged = hNewText.as_handle() != hPrevText.as_handle() && !hNewText.strictlyEquals(hPrevText);
+    } else if (!a_pNewNode->isJsText() && !a_pPrevNode->isJsText()) {
+        bChanged = a_pNewNode->getText() != a_pPrevNode->getText();
+    }
+
+    if (bChanged && a_pNewNode->isJsText()) {
+        VOLT_DEBUG("Volt>DiffPatch", "syncTextNodes(): changing JS text");
+        dom::setNodeValue(hElement, a_pNewNode->getJsText());
+    } else if (bChanged) {
         VOLT_DEBUG(
             "Volt>DiffPatch",
-            "syncTextNodes(): changing text from '" + a_pPrevNode->getText() +
-            "' to '" + a_pNewNode->getText() + "'"
+            "syncTextNodes(): changing text to '" + std::string(a_pNewNode->getText()) + "'"
         );
-        hElement.set("nodeValue", emscripten::val(a_pNewNode->getText()));
+        dom::setNodeValue(hElement, a_pNewNode->getText());
     } else {
-        VOLT_TRACE(
-            "Volt>DiffPatch",
-            "syncTextNodes(): text unchanged '" + a_pNewNode->getText() + "'"
-        );
+        VOLT_TRACE("Volt>DiffPatch", "syncTextNodes(): text unchanged");
     }
 
     transferNode(a_pNewNode, hElement);
@@ -280,10 +441,13 @@ void VoltDiffPatch::syncNodes(
         "syncNodes(): entering for tag='" + a_pNewNode->getTagName() + "'"
     );
     VOLT_LOG_INDENT_PUSH();
+    VOLT_SPAN_NODE_VISITED();
+    VOLT_SPAN(SpanCategory::SUBTREE, tag::tagToString(a_pNewNode->getTag()));
 
     emscripten::val hElement = a_pOldNode->getMatchingElement();
 
     transferNode(a_pNewNode, hElement);
+    a_focusManager.transfer(a_pOldNode, a_pNewNode);
 
     // Sync non-bubble props (event handlers)
     // ---------------------------
@@ -308,11 +472,7 @@ void VoltDiffPatch::syncNodes(
                     "syncNodes(): adding non-bubble event attrId=" +
                     std::string("on") + attr::attrIdToName(itNewEvent->first)
                 );
-                hElement.call<void>(
-                    "addEventListener", 
-                    std::string(attr::attrIdToName(itNewEvent->first)),
-                    nonBubbleHandler()
-                );
+                addNonBubbleListener(hElement, itNewEvent->first);
                 ++itNewEvent;
             }
         } else if (itNewEvent == newEvents.cend()) { // Remaining items in old are removals
@@ -322,11 +482,7 @@ void VoltDiffPatch::syncNodes(
                     "syncNodes(): removing non-bubble event attrId=" +
                     std::string("on") + attr::attrIdToName(itOldEvent->first)
                 );
-                hElement.call<void>(
-                    "removeEventListener", 
-                    std::string(attr::attrIdToName(itOldEvent->first)),
-                    nonBubbleHandler()
-                );
+                removeNonBubbleListener(hElement, itOldEvent->first);
                 ++itOldEvent;
             }
         } else if (itOldEvent->first < itNewEvent->first) {
@@ -336,11 +492,7 @@ void VoltDiffPatch::syncNodes(
                 "syncNodes(): removing non-bubble event attrId=" +
                 std::string("on") + attr::attrIdToName(itOldEvent->first)
             );
-            hElement.call<void>(
-                "removeEventListener", 
-                std::string(attr::attrIdToName(itOldEvent->first)),
-                nonBubbleHandler()
-            );
+            removeNonBubbleListener(hElement, itOldEvent->first);
             ++itOldEvent;
         } else if (itNewEvent->first < itOldEvent->first) {
             // New key not in old = addition
@@ -349,14 +501,10 @@ void VoltDiffPatch::syncNodes(
                 "syncNodes(): adding non-bubble event attrId=" +
                 std::string("on") + attr::attrIdToName(itNewEvent->first)
             );
-            hElement.call<void>(
-                "addEventListener", 
-                std::string(attr::attrIdToName(itNewEvent->first)),
-                nonBubbleHandler()
-            );
+            addNonBubbleListener(hElement, itNewEvent->first);
             ++itNewEvent;
         } else {
-            // Same key, update to new callback, we got a new a_pNewNode pointer
+            // Same key, the listener stays, it dispatches through the new node's __volt_node
             VOLT_DEBUG(
                 "Volt>DiffPatch",
                 "syncNodes(): unchanged non-bubble event attrId=" +
@@ -391,8 +539,8 @@ void VoltDiffPatch::syncNodes(
                 );
                 dom::setAttribute(
                     hElement,
-                    attr::attrIdToName(newProps[nNewPropIdx].first),
-                    newProps[nNewPropIdx].second.c_str()
+                    newProps[nNewPropIdx].first,
+                    newProps[nNewPropIdx].second
                 );
                 ++nNewPropIdx;
             }
@@ -405,7 +553,7 @@ void VoltDiffPatch::syncNodes(
                 );
                 dom::removeAttribute(
                     hElement,
-                    attr::attrIdToName(oldProps[nOldPropIdx].first)
+                    oldProps[nOldPropIdx].first
                 );
                 ++nOldPropIdx;
             }
@@ -418,7 +566,7 @@ void VoltDiffPatch::syncNodes(
             );
             dom::removeAttribute(
                 hElement,
-                attr::attrIdToName(oldProps[nOldPropIdx].first)
+                oldProps[nOldPropIdx].first
             );
             ++nOldPropIdx;
         } else if (newProps[nNewPropIdx].first < oldProps[nOldPropIdx].first) {
@@ -430,8 +578,8 @@ void VoltDiffPatch::syncNodes(
             );
             dom::setAttribute(
                 hElement,
-                attr::attrIdToName(newProps[nNewPropIdx].first),
-                newProps[nNewPropIdx].second.c_str()
+                newProps[nNewPropIdx].first,
+                newProps[nNewPropIdx].second
             );
             ++nNewPropIdx;
         } else {
@@ -444,8 +592,8 @@ void VoltDiffPatch::syncNodes(
                 );
                 dom::setAttribute(
                     hElement,
-                    attr::attrIdToName(newProps[nNewPropIdx].first),
-                    newProps[nNewPropIdx].second.c_str()
+                    newProps[nNewPropIdx].first,
+                    newProps[nNewPropIdx].second
                 );
             } else {
                 VOLT_TRACE(
@@ -459,6 +607,17 @@ void VoltDiffPatch::syncNodes(
         }
     }
 
+    // Sync volt::String props
+    // ---------------------------
+    syncJsProps(hElement, a_pOldNode->getJsProps(), a_pNewNode->getJsProps(), newProps);
+
+    // Sync structured style and class, animated ones first so a property
+    // that goes back to a plain styleprop() is written after being cleared
+    // ---------------------------
+    syncAnimatedProps(hElement, a_pOldNode, a_pNewNode);
+    syncStyleProps(hElement, a_pOldNode, a_pNewNode);
+    syncClassTokens(hElement, a_pOldNode, a_pNewNode);
+
     // Sync children
     // ---------------------------
     if (a_pOldNode->getChildren().size() > 0 || a_pNewNode->getChildren().size() > 0) {
@@ -486,6 +645,287 @@ void VoltDiffPatch::syncNodes(
     );
 }
 
+void VoltDiffPatch::syncJsProps(
+    emscripten::val a_hElement,
+    const std::vector<std::pair<short, emscripten::val>>& a_oldJsProps,
+    const std::vector<std::pair<short, emscripten::val>>& a_newJsProps,
+    const std::vector<std::pair<short, std::string>>& a_newProps)
+{
+    // Walk both sorted vectors in parallel
+    size_t nOldIdx = 0;
+    size_t nNewIdx = 0;
+    while (nOldIdx < a_oldJsProps.size() || nNewIdx < a_newJsProps.size()) {
+        int nCompare =
+            nOldIdx == a_oldJsProps.size() ? 1 :
+            nNewIdx == a_newJsProps.size() ? -1 :
+            a_oldJsProps[nOldIdx].first - a_newJsProps[nNewIdx].first;
+
+        if (nCompare < 0) {
+            // Removal, unless the prop is now a std::string and was just written
+            short nAttrId = a_oldJsProps[nOldIdx].first;
+            bool bNowString = std::binary_search(a_newProps.begin(), a_newProps.end(), std::make_pair(nAttrId, std::string()),
+                [](const auto& a_a, const auto& a_b) { return a_a.first < a_b.first; });
+            if (!bNowString) {
+                VOLT_DEBUG("Volt>DiffPatch", "syncJsProps(): removing prop attrId=" + std::string(attr::attrIdToName(nAttrId)));
+                dom::removeAttribute(a_hElement, nAttrId);
+            }
+            ++nOldIdx;
+        } else if (nCompare > 0) {
+            VOLT_DEBUG("Volt>DiffPatch", "syncJsProps(): adding prop attrId=" + std::string(attr::attrIdToName(a_newJsProps[nNewIdx].first)));
+            dom::setAttribute(a_hElement, a_newJsProps[nNewIdx].first, a_newJsProps[nNewIdx].second);
+            ++nNewIdx;
+        } else {
+            // Same handle needs no JS call, a different one holding an equal string no write
+            const emscripten::val& hOld = a_oldJsProps[nOldIdx].second;
+            const emscripten::val& hNew = a_newJsProps[nNewIdx].second;
+            if (hOld.as_handle() != hNew.as_handle() && !hOld.strictlyEquals(hNew)) {
+                VOLT_DEBUG("Volt>DiffPatch", "syncJsProps(): updating prop attrId=" + std::string(attr::attrIdToName(a_newJsProps[nNewIdx].first)));
+                dom::setAttribute(a_hElement, a_newJsProps[nNewIdx].first, hNew);
+            }
+            ++nOldIdx;
+            ++nNewIdx;
+        }
+    }
+}
+
+void VoltDiffPatch::syncStyleProps(
+    emscripten::val a_hElement,
+    VNode* a_pOldNode,
+    VNode* a_pNewNode)
+{
+    static const std::vector<attr::StyleProp> s_noStyleProps;
+    const std::vector<attr::StyleProp>& newStyleProps = a_pNewNode->getStyleProps();
+    if (newStyleProps.empty() && (a_pOldNode == nullptr || a_pOldNode->getStyleProps().empty())) {
+        return;
+    }
+    bool bRewritten = a_pOldNode == nullptr || propChanged(a_pOldNode, a_pNewNode, attr::ATTR_style);
+    const std::vector<attr::StyleProp>& oldStyleProps = bRewritten ? s_noStyleProps : a_pOldNode->getStyleProps();
+
+    // Fetched on first change only, unchanged declarations cost no DOM call at all
+    emscripten::val hStyle = emscripten::val::undefined();
+    auto style = [&]() -> emscripten::val& {
+        if (hStyle.isUndefined()) {
+            hStyle = a_hElement["style"];
+        }
+        return hStyle;
+    };
+
+    // Walk both sorted vectors in parallel
+    size_t nOldIdx = 0;
+    size_t nNewIdx = 0;
+    while (nOldIdx < oldStyleProps.size() || nNewIdx < newStyleProps.size()) {
+        int nCompare =
+            nOldIdx == oldStyleProps.size() ? 1 :
+            nNewIdx == newStyleProps.size() ? -1 :
+            oldStyleProps[nOldIdx].property.compare(newStyleProps[nNewIdx].property);
+
+        if (nCompare < 0) {
+            // Old property not in new = removal
+            VOLT_DEBUG("Volt>DiffPatch", "syncStyleProps(): removing " + std::string(oldStyleProps[nOldIdx].property.view()));
+            dom::removeStyleProperty(style(), oldStyleProps[nOldIdx].property.view());
+            ++nOldIdx;
+        } else if (nCompare > 0) {
+            // New property not in old = addition
+            VOLT_DEBUG("Volt>DiffPatch", "syncStyleProps(): adding " + std::string(newStyleProps[nNewIdx].property.view()));
+            dom::setStyleProperty(style(), newStyleProps[nNewIdx].property.view(), newStyleProps[nNewIdx].value.view());
+            ++nNewIdx;
+        } else {
+            // Same property, write only if the value changed. A literal value compares by address.
+            if (!(oldStyleProps[nOldIdx].value == newStyleProps[nNewIdx].value)) {
+                VOLT_DEBUG("Volt>DiffPatch", "syncStyleProps(): updating " + std::string(newStyleProps[nNewIdx].property.view()));
+                dom::setStyleProperty(style(), newStyleProps[nNewIdx].property.view(), newStyleProps[nNewIdx].value.view());
+            }
+            ++nOldIdx;
+            ++nNewIdx;
+        }
+    }
+}
+
+bool VoltDiffPatch::propChanged(VNode* a_pOldNode, VNode* a_pNewNode, short a_nAttrId) {
+    // Props and JS props are sorted by id, a prop is in one of them at most
+    auto findProp = [a_nAttrId](const auto& a_props) {
+        auto it = std::lower_bound(a_props.begin(), a_props.end(), a_nAttrId,
+            [](const auto& a_prop, short a_nId) { return a_prop.first < a_nId; });
+        return (it != a_props.end() && it->first == a_nAttrId) ? &it->second : nullptr;
+    };
+    const std::string* pOld = findProp(a_pOldNode->getProps());
+    const std::string* pNew = findProp(a_pNewNode->getProps());
+    const emscripten::val* pOldJs = findProp(a_pOldNode->getJsProps());
+    const emscripten::val* pNewJs = findProp(a_pNewNode->getJsProps());
+
+    if (pOld != nullptr && pNew != nullptr) {
+        return *pOld != *pNew;
+    }
+    if (pOldJs != nullptr && pNewJs != nullptr) {
+        return pOldJs->as_handle() != pNewJs->as_handle() && !pOldJs->strictlyEquals(*pNewJs);
+    }
+    return (pOld != nullptr || pOldJs != nullptr) || (pNew != nullptr || pNewJs != nullptr);
+}
+
+void VoltDiffPatch::syncAnimatedProps(
+    emscripten::val a_hElement,
+    VNode* a_pOldNode,
+    VNode* a_pNewNode)
+{
+    static std::vector<attr::AnimatedProp> s_noProps;
+    std::vector<attr::AnimatedProp>& oldProps = a_pOldNode != nullptr ? a_pOldNode->getAnimatedProps() : s_noProps;
+    std::vector<attr::AnimatedProp>& newProps = a_pNewNode->getAnimatedProps();
+    if (oldProps.empty() && newProps.empty()) {
+        return;
+    }
+
+    // Few per element, a scan finds the matching binding
+    auto sameTarget = [](const attr::AnimatedProp& a_a, const attr::AnimatedProp& a_b) {
+        return a_a.nAttrId == a_b.nAttrId && a_a.property == a_b.property;
+    };
+    auto sameBinding = [&](const attr::AnimatedProp& a_a, const attr::AnimatedProp& a_b) {
+        return a_a.pAnimated == a_b.pAnimated && sameTarget(a_a, a_b) && a_a.prefix == a_b.prefix && a_a.suffix == a_b.suffix;
+    };
+
+    // A style cssText write this frame wiped the animated CSS properties, kept ones are written again
+    bool bCssTextWritten = a_pOldNode != nullptr && propChanged(a_pOldNode, a_pNewNode, attr::ATTR_style);
+
+    for (const attr::AnimatedProp& newProp : newProps) {
+        if (newProp.pAnimated == nullptr) {
+            continue;
+        }
+        bool bKept = std::any_of(oldProps.begin(), oldProps.end(),
+            [&](const attr::AnimatedProp& a_oldProp) { return sameBinding(a_oldProp, newProp); });
+        if (bKept) {
+            // The element already shows the last frame's value
+            newProp.pAnimated->rebind(a_pOldNode->getNodeId(), a_pNewNode->getNodeId());
+            if (bCssTextWritten && newProp.nAttrId == attr::ATTR_styleprop) {
+                newProp.pAnimated->writeTo(a_hElement, newProp);
+            }
+        } else {
+            VOLT_DEBUG("Volt>DiffPatch", "syncAnimatedProps(): binding " + std::string(newProp.nAttrId == attr::ATTR_styleprop ? newProp.property : attr::attrIdToName(newProp.nAttrId)));
+            newProp.pAnimated->bind(a_pNewNode->getNodeId());
+            newProp.pAnimated->writeTo(a_hElement, newProp);
+        }
+    }
+
+    for (const attr::AnimatedProp& oldProp : oldProps) {
+        if (oldProp.pAnimated != nullptr) {
+            oldProp.pAnimated->unbind(a_pOldNode->getNodeId()); // No-op when rebound above
+        }
+        bool bWritten = std::any_of(newProps.begin(), newProps.end(),
+            [&](const attr::AnimatedProp& a_newProp) { return sameTarget(a_newProp, oldProp); });
+        if (!bWritten) {
+            AnimatedBase::clearFrom(a_hElement, oldProp);
+        }
+    }
+}
+
+void VoltDiffPatch::unbindAnimated(VNode* a_pNode) {
+    if (!AnimatedBase::hasBindings()) {
+        return; // Nothing bound anywhere, no need to walk the subtree
+    }
+    for (const attr::AnimatedProp& prop : a_pNode->getAnimatedProps()) {
+        if (prop.pAnimated != nullptr) { // nullptr once its Animated is gone
+            prop.pAnimated->unbind(a_pNode->getNodeId());
+        }
+    }
+    for (VNode* pChild : a_pNode->getChildren()) {
+        unbindAnimated(pChild);
+    }
+}
+
+void VoltDiffPatch::syncClassTokens(
+    emscripten::val a_hElement,
+    VNode* a_pOldNode,
+    VNode* a_pNewNode)
+{
+    static const std::vector<attr::SharedText> s_noClassTokens;
+    const std::vector<attr::SharedText>& newClassTokens = a_pNewNode->getClassTokens();
+    if (newClassTokens.empty() && (a_pOldNode == nullptr || a_pOldNode->getClassTokens().empty())) {
+        return;
+    }
+    bool bRewritten = a_pOldNode == nullptr || propChanged(a_pOldNode, a_pNewNode, attr::ATTR_classname);
+    const std::vector<attr::SharedText>& oldClassTokens = bRewritten ? s_noClassTokens : a_pOldNode->getClassTokens();
+
+    // A token that goes away stays when classname() still lists it. The classname is looked up
+    // (and a JS one decoded) on the first removal, once for all of them.
+    static const std::string s_sNoClassName;
+    const std::string* pClassName = nullptr;
+    std::string sJsClassName;
+    auto inClassName = [&](std::string_view a_sToken) {
+        if (pClassName == nullptr) {
+            pClassName = &s_sNoClassName;
+            for (const auto& [nAttrId, sValue] : a_pNewNode->getProps()) {
+                if (nAttrId == attr::ATTR_classname) {
+                    pClassName = &sValue;
+                }
+            }
+            for (const auto& [nAttrId, hValue] : a_pNewNode->getJsProps()) {
+                if (nAttrId == attr::ATTR_classname) {
+                    sJsClassName = hValue.as<std::string>();
+                    pClassName = &sJsClassName;
+                }
+            }
+        }
+        const std::string& sClassName = *pClassName;
+        size_t nPos = 0;
+        while ((nPos = sClassName.find(a_sToken, nPos)) != std::string::npos) {
+            size_t nEnd = nPos + a_sToken.size();
+            bool bStart = nPos == 0 || std::isspace(static_cast<unsigned char>(sClassName[nPos - 1]));
+            bool bEnd = nEnd == sClassName.size() || std::isspace(static_cast<unsigned char>(sClassName[nEnd]));
+            if (bStart && bEnd) {
+                return true;
+            }
+            nPos = nEnd;
+        }
+        return false;
+    };
+
+    // Fetched on first change only, unchanged tokens cost no DOM call at all
+    emscripten::val hClassList = emscripten::val::undefined();
+    auto classList = [&]() -> emscripten::val& {
+        if (hClassList.isUndefined()) {
+            hClassList = a_hElement["classList"];
+        }
+        return hClassList;
+    };
+
+    // Walk both sorted vectors in parallel
+    size_t nOldIdx = 0;
+    size_t nNewIdx = 0;
+    while (nOldIdx < oldClassTokens.size() || nNewIdx < newClassTokens.size()) {
+        int nCompare =
+            nOldIdx == oldClassTokens.size() ? 1 :
+            nNewIdx == newClassTokens.size() ? -1 :
+            oldClassTokens[nOldIdx].compare(newClassTokens[nNewIdx]);
+
+        if (nCompare < 0) {
+            // Old token not in new = removal
+            std::string_view sToken = oldClassTokens[nOldIdx].view();
+            if (!inClassName(sToken)) {
+                VOLT_DEBUG("Volt>DiffPatch", "syncClassTokens(): removing " + std::string(sToken));
+                dom::removeClass(classList(), sToken);
+            }
+            ++nOldIdx;
+        } else if (nCompare > 0) {
+            // New token not in old = addition
+            VOLT_DEBUG("Volt>DiffPatch", "syncClassTokens(): adding " + std::string(newClassTokens[nNewIdx].view()));
+            dom::addClass(classList(), newClassTokens[nNewIdx].view());
+            ++nNewIdx;
+        } else {
+            ++nOldIdx;
+            ++nNewIdx;
+        }
+    }
+}
+
+bool VoltDiffPatch::claimBroughtNode(
+    std::unordered_set<VNode*>& a_unclaimedOldNodes,
+    const std::vector<VNode*>& a_prevNodes,
+    VNode* a_pOldNode) {
+    // Siblings walked past are unclaimed, a linked sibling that is still claimed lies ahead
+    bool bUnclaimed = a_unclaimedOldNodes.erase(a_pOldNode) > 0;
+    return bUnclaimed &&
+           a_pOldNode->getParent() != nullptr &&
+           &a_pOldNode->getParent()->getChildren() == &a_prevNodes;
+}
+
 void VoltDiffPatch::bringAndSyncNodes(
     IdManager& a_idManager, 
     FocusManager& a_focusManager,
@@ -502,6 +942,8 @@ void VoltDiffPatch::bringAndSyncNodes(
     );
     VOLT_LOG_INDENT_PUSH();
 
+    VOLT_PROFILE_COUNT(nodesMoved);
+
     // Remove from parents' child list
     a_pOldNode->unlink();
 
@@ -522,7 +964,7 @@ void VoltDiffPatch::bringAndSyncNodes(
         dom::insertBefore(a_hContainer, a_pOldNode->getMatchingElement(), a_hReferenceNode);
     }
 
-    a_pNewNode->onMoveElement(a_pOldNode->getMatchingElement());
+    dom::afterCommit([a_pNewNode, a_pOldNode]() { a_pNewNode->onMoveElement(a_pOldNode->getMatchingElement()); });
 
     // Sync props and children
     syncNodes(a_idManager, a_focusManager, a_unclaimedOldNodes, a_pNewNode, a_pOldNode);
@@ -539,17 +981,23 @@ void VoltDiffPatch::addNode(
     VOLT_DEBUG(
         "Volt>DiffPatch",
         std::string("addNode(): creating new ") +
-        (a_pNewNode->isText() ? "text node with >> " + a_pNewNode->getText() : "element node tag='" + a_pNewNode->getTagName() + "'")
+        (a_pNewNode->isText() ? "text node with >> " + std::string(a_pNewNode->getText()) : "element node tag='" + a_pNewNode->getTagName() + "'")
     );
     VOLT_LOG_INDENT_PUSH();
 
+    VOLT_PROFILE_COUNT(nodesCreated);
+    VOLT_SPAN_NODE_VISITED();
+    VOLT_SPAN(SpanCategory::SUBTREE, tag::tagToString(a_pNewNode->getTag()));
+
     emscripten::val hNewElement = emscripten::val::undefined();
 
     if (a_pNewNode->isText()) {
-        hNewElement = dom::createTextNode(a_pNewNode->getText());
+        hNewElement = a_pNewNode->isJsText()
+            ? dom::createTextNode(a_pNewNode->getJsText())
+            : dom::createTextNode(a_pNewNode->getText());
     }
     else {
-        hNewElement = dom::createElement(tag::tagToString(a_pNewNode->getTag()));
+        hNewElement = dom::createElement(a_pNewNode->getTag());
 
         for (const auto& [eventAttrId, value] : a_pNewNode->getNonBubbleEvents()) {
             VOLT_TRACE(
@@ -557,11 +1005,7 @@ void VoltDiffPatch::addNode(
                 "addNode(): adding non-bubble event attrId=" +
                 std::string(attr::attrIdToName(eventAttrId))
             );
-            hNewElement.call<void>(
-                "addEventListener", 
-                std::string(attr::attrIdToName(eventAttrId)),
-                nonBubbleHandler()
-            );
+            addNonBubbleListener(hNewElement, eventAttrId);
         }
 
         for (auto & [attrId, value] : a_pNewNode->getProps()) {
@@ -569,26 +1013,35 @@ void VoltDiffPatch::addNode(
                 "Volt>DiffPatch",
                 "addNode(): setting initial prop attrId=" + std::string(attr::attrIdToName(attrId))
             );
-            dom::setAttribute(hNewElement, attr::attrIdToName(attrId), value);
+            dom::setAttribute(hNewElement, attrId, value);
+        }
+        for (const auto& [attrId, hValue] : a_pNewNode->getJsProps()) {
+            dom::setAttribute(hNewElement, attrId, hValue);
         }
 
+        syncAnimatedProps(hNewElement, nullptr, a_pNewNode);
+        syncStyleProps(hNewElement, nullptr, a_pNewNode);
+        syncClassTokens(hNewElement, nullptr, a_pNewNode);
+
         a_idManager.pushVNodeToken(a_pNewNode);
-        std::string sId = a_idManager.build();
+        const std::string& sId = a_idManager.build();
         VOLT_TRACE("Volt>DiffPatch", "addNode(): registering stable id=" + sId);
 
         for (VNode* pChild : a_pNewNode->getChildren()) {
             addNode(a_idManager, pChild, hNewElement, emscripten::val::undefined());
         }
-        
-        a_idManager.popToken();
 
         a_idManager.addVNode(sId, a_pNewNode);
-
-        a_pNewNode->onAddElement(hNewElement);
+        a_idManager.popToken();
     }
 
     transferNode(a_pNewNode, hNewElement);
 
+    if (!a_pNewNode->isText()) {
+        // With a patch buffer the element is only in the document once the patch is applied
+        dom::afterCommit([a_pNewNode]() { a_pNewNode->onAddElement(a_pNewNode->getMatchingElement()); });
+    }
+
     if (a_hReferenceNode.isUndefined()) {
         VOLT_TRACE("Volt>DiffPatch", "addNode(): appending to container");
         dom::appendChild(a_hContainer, hNewElement);
@@ -614,13 +1067,27 @@ void VoltDiffPatch::transferNode(
     a_pNewNode->setMatchingElement(a_hElement);
 
     // For bubble events. Set back-reference to this VNode in the DOM element
-    a_hElement.set("__cpp_ptr", reinterpret_cast<intptr_t>(a_pNewNode));
+    a_hElement.set("__volt_node", a_pNewNode->getNodeId());
 
     VOLT_LOG_INDENT_POP();
 }
 
 emscripten::val VoltDiffPatch::nonBubbleHandler() {
-    return emscripten::val::module_property("invokeVoltNonBubbleEvent");
+    static const emscripten::val s_hHandler = emscripten::val::module_property("invokeVoltNonBubbleEvent");
+    return s_hHandler;
+}
+
+void VoltDiffPatch::addNonBubbleListener(emscripten::val a_hElement, short a_nEventId) {
+    // Delegated events are dispatched by volt.js from the container, the element needs no listener
+    if (!attr::isDelegatedEvent(a_nEventId)) {
+        dom::addEventListener(a_hElement, a_nEventId, nonBubbleHandler());
+    }
+}
+
+void VoltDiffPatch::removeNonBubbleListener(emscripten::val a_hElement, short a_nEventId) {
+    if (!attr::isDelegatedEvent(a_nEventId)) {
+        dom::removeEventListener(a_hElement, a_nEventId, nonBubbleHandler());
+    }
 }
 
 } // namespace volt
@@ -9,10 +9,20 @@
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include <array>
+#include <stdint.h>
 #include "IRuntime.hpp"
 #include "App.hpp"
 #include "IdManager.hpp"
 #include "FocusManager.hpp"
+#include "VoltProfiler.hpp"
+#include "VoltSpan.hpp"
+#include "VoltScheduler.hpp"
+
+// Number of recent frames whose largest VNode count the pool shrinks back to
+#ifndef VOLT_POOL_TRIM_WINDOW
+#define VOLT_POOL_TRIM_WINDOW 120
+#endif
 
 namespace volt {
 
@@ -27,16 +37,21 @@ public:
     // Constructor: Create a runtime bound to a DOM element by ID
     explicit    VoltEngine                 (std::string a_sElementId, std::string a_sModuleName);
     
-    // Destructor: Clean up DOM and callbacks
+    // Destructor: Unmount the DOM, detach listeners and back-references, free the pool
                 ~VoltEngine                ();
     
     // IRuntime interface implementation
     void        invalidate                  () override;
+    void        spawn                       (Task a_task) override;
     
     // Mount app
     template<typename TApp> void 
                 mountApp                    ();
 
+    // Render order among engines invalidated for the same frame, higher first
+    void        setPriority                 (int a_nPriority) { m_nPriority = a_nPriority; }
+    int         getPriority                 () const { return m_nPriority; }
+
     // Id manager for stable element mapping
     std::string 
                 getModuleName               () { return m_sModuleName; }
@@ -45,20 +60,31 @@ public:
     IdManager& 
                 getIdManager                () { return m_idManager; }
 
+    // Focus tracking, fed by volt.js: the focused element's __volt_node, or clear when focus left
     void        clearFocussedElements       ();
-    void        addFocussedElement          (emscripten::val a_hElement);
+    void        setFocussedNode             (VNodeId a_nNodeId);
 
     // VNode free list for recycling
     VNode*      recycleVNode                ();
 
+#ifdef VOLT_ENABLE_PROFILER
+    // Measurements of the last rendered frame
+    const FrameStats& 
+                getLastFrameStats           () const { return m_frameStats; }
+#endif
+
 private:
-    // Render loop callback
-    static EM_BOOL 
-                onAnimationFrame            (double a_nTimestamp, void* a_pThisAsVoidStar);
+    friend class VoltScheduler;
+
+    // Called by the scheduler once per frame the engine was queued for
+    void        onFrame                     ();
 
     // Perform the actual render
     void        doRender                    ();
 
+    // Free every VNode the last render did not build and trim the pool
+    void        reclaimVNodes               ();
+
     // MEMBERS 
 
     // DOM element handle for mounting
@@ -77,6 +103,8 @@ private:
 
     // Render scheduling
     bool        m_bHasInvalidated = false;
+    bool        m_bDestroying = false;
+    int         m_nPriority = 0;
 
     // Id manager for stable element mapping
     IdManager   m_idManager;
@@ -89,6 +117,16 @@ private:
     std::vector<std::unique_ptr<VNode>> 
                 m_poolVNode;
     VNode*      m_pVNodeFreeListHead = nullptr; //free list for recycling
+    uint32_t    m_nVNodeGeneration = 0; // Stamped on every VNode built by the current render
+    size_t      m_nVNodesThisFrame = 0;
+    size_t      m_nFrameCount = 0;
+    std::array<size_t, VOLT_POOL_TRIM_WINDOW>
+                m_vnodesPerFrame{}; // Ring of recent frames, for the high-water mark
+
+#ifdef VOLT_ENABLE_PROFILER
+    // Per-frame profiler measurements
+    FrameStats  m_frameStats;
+#endif
 };
 
 } // namespace volt
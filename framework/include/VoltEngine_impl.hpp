@@ -27,18 +27,51 @@ VoltEngine::VoltEngine(std::string a_sElementId, std::string a_sModuleName) {
 }
 
 VoltEngine::~VoltEngine() {
-    // TODO: Clear and free other things here
+    // From here on invalidate() and spawn() do nothing, teardown code can't queue this engine again
+    m_bDestroying = true;
+
+    // Unmount before the app goes, the remove hooks may still call into it
+    if (m_pCurrentVTree != nullptr) {
+        VoltDiffPatch::unmount(m_pCurrentVTree, m_hHostElement);
+        m_pCurrentVTree = nullptr;
+    }
+    m_focusManager.clear();
+
+    // A pending frame must not call into a destroyed engine. Tasks are cancelled while the app they reference is still alive.
+    VoltScheduler::instance().unschedule(this);
+    m_pApp.reset();
+
+    // The VNode pool releases the remaining element handles and closures
+    m_pVNodeFreeListHead = nullptr;
+    for (const std::unique_ptr<VNode>& pNode : m_poolVNode) {
+        VNodeTable::instance().remove(pNode->getNodeId());
+    }
+    m_poolVNode.clear();
 }
 
 void VoltEngine::invalidate() {
-    if (m_bHasInvalidated) {
-        return; // Already requested
+    if (m_bHasInvalidated || m_bDestroying) {
+        return; // Already requested, or tearing down
     }
 
     m_bHasInvalidated = true;
 
-    // Request animation frame with this runtime as user data
-    emscripten_request_animation_frame(onAnimationFrame, this);
+    // Batched with every other engine into one animation frame
+    VoltScheduler::instance().schedule(this);
+}
+
+void VoltEngine::spawn(Task a_task) {
+    if (m_bDestroying) {
+        return; // The task is destroyed unstarted
+    }
+
+    Task::Handle handle = a_task.release();
+    if (!handle) {
+        return;
+    }
+    handle.promise().pOwner = this;
+    handle.promise().deadline = TaskDeadline{emscripten_get_now() + VOLT_TASK_SLICE_MS};
+    handle.resume(); // Runs up to its first co_await
 }
 
 template<typename TApp> 
@@ -52,33 +85,75 @@ void VoltEngine::mountApp() {
 void VoltEngine::clearFocussedElements() {
     m_focusManager.clear();
 }
-    
-void VoltEngine::addFocussedElement(emscripten::val a_hElement) {
-    m_focusManager.add(a_hElement);
+
+void VoltEngine::setFocussedNode(VNodeId a_nNodeId) {
+    m_focusManager.focus(a_nNodeId);
 }
 
 VNode* VoltEngine::recycleVNode() {
+    VNode* pNode = nullptr;
     if (m_pVNodeFreeListHead == nullptr) {
         // Allocate a new VNode
         m_poolVNode.push_back(std::make_unique<VNode>(tag::ETag::div));
-        return m_poolVNode.back().get();
+        pNode = m_poolVNode.back().get();
+        pNode->setEngine(this);
+        pNode->setNodeId(VNodeTable::instance().add(pNode));
     } else {
         // Reuse from free list
-        VNode* pFreeNode = m_pVNodeFreeListHead;
+        pNode = m_pVNodeFreeListHead;
         m_pVNodeFreeListHead = m_pVNodeFreeListHead->getParent();
-        return pFreeNode;
     }
+    pNode->setGeneration(m_nVNodeGeneration);
+    ++m_nVNodesThisFrame;
+    return pNode;
 }
 
-EM_BOOL VoltEngine::onAnimationFrame(double a_nTimestamp, void* a_pThisAsVoidStar) {
-    auto* pRuntime = static_cast<VoltEngine*>(a_pThisAsVoidStar);
+void VoltEngine::reclaimVNodes() {
+    // High-water mark of VNodes built per frame, over the recent frames
+    m_vnodesPerFrame[m_nFrameCount++ % m_vnodesPerFrame.size()] = m_nVNodesThisFrame;
+    m_nVNodesThisFrame = 0;
+    size_t nHighWater = *std::max_element(m_vnodesPerFrame.begin(), m_vnodesPerFrame.end());
+
+    // Nodes built by the last render are the current VTree, everything else is free.
+    // This includes text and fragment nodes, which the id stores never see.
+    uint32_t nLiveGeneration = m_nVNodeGeneration++;
+    auto itFree = std::partition(m_poolVNode.begin(), m_poolVNode.end(),
+        [nLiveGeneration](const std::unique_ptr<VNode>& a_pNode) { return a_pNode->getGeneration() == nLiveGeneration; });
+
+    // Keep one frame's worth of free nodes, a transient peak is given back
+    size_t nFree = m_poolVNode.end() - itFree;
+    if (nFree > 2 * nHighWater) {
+        for (auto it = itFree + nHighWater; it != m_poolVNode.end(); ++it) {
+            VNodeTable::instance().remove((*it)->getNodeId());
+        }
+        m_poolVNode.erase(itFree + nHighWater, m_poolVNode.end());
+        if (m_poolVNode.capacity() > 2 * m_poolVNode.size()) {
+            m_poolVNode.shrink_to_fit();
+        }
+        itFree = m_poolVNode.end() - nHighWater;
+    }
 
-    if (pRuntime->m_bHasInvalidated) {
-        pRuntime->m_bHasInvalidated = false; // Reset invalidation flag, before rendering
-        pRuntime->doRender();
+    m_pVNodeFreeListHead = nullptr;
+    for (auto it = itFree; it != m_poolVNode.end(); ++it) {
+        VNode* pNode = it->get();
+        if (pNode->getGeneration() + 1 == nLiveGeneration) {
+            // Freed just now: drop its element handle and closures so they don't outlive the DOM,
+            // and let the DOM's handles to it go stale
+            pNode->reuse(tag::ETag::div);
+            pNode->setNodeId(VNodeTable::instance().renew(pNode->getNodeId()));
+        }
+        pNode->setParent(m_pVNodeFreeListHead);
+        m_pVNodeFreeListHead = pNode;
+    }
+
+    m_idManager.startGeneration(nHighWater);
+}
+
+void VoltEngine::onFrame() {
+    if (m_bHasInvalidated) {
+        m_bHasInvalidated = false; // Reset invalidation flag, before rendering
+        doRender();
     }
-    
-    return EM_FALSE; // Don't repeat automatically
 }
 
 void VoltEngine::doRender() {
@@ -90,8 +165,13 @@ void VoltEngine::doRender() {
 
     //log("VoltEngine::doRender here 1");
 
-    // Prepare key manager for new render
-    m_idManager.startGeneration(&m_pVNodeFreeListHead);
+    VOLT_PROFILE_FRAME_BEGIN(m_frameStats);
+    VOLT_SPANS_FRAME_BEGIN();
+    VOLT_SPAN(SpanCategory::ENGINE, "Volt doRender");
+
+    // Recycle the VNodes of the render before last, prepare key manager for new render
+    reclaimVNodes();
+    TextArena::instance().reset(); // Formatted text of earlier renders is formatted again when needed
 
     //log("VoltEngine::doRender here 2");
 
@@ -101,18 +181,39 @@ void VoltEngine::doRender() {
     g_pRenderingEngine = this;
     
     // Render the new VTree, put inside a fragment to always work with a list of children
-    VNode* pNewVTree = tag::_fragment(m_pApp->render()).getNodePtr();
+    VNode* pNewVTree = nullptr;
+    {
+        VOLT_PROFILE_SCOPE(renderMs);
+        VOLT_SPAN(SpanCategory::COMPONENT, "App::render");
+        pNewVTree = tag::_fragment(m_pApp->render()).getNodePtr();
+    }
 
     //log("VoltEngine::doRender here 4");
 
-    if (m_pCurrentVTree == nullptr) {
-        // Initial render: create DOM from scratch
-        VoltDiffPatch::rebuild(m_idManager, m_focusManager, pNewVTree, m_hHostElement);
-    } else {
-        // Reconcile the prev and new trees, then patch the DOM
-        VoltDiffPatch::diffPatch(m_idManager, m_focusManager, m_pCurrentVTree, pNewVTree, m_hHostElement);
+    {
+        VOLT_PROFILE_SCOPE(walkMs);
+        VOLT_SPAN(SpanCategory::ENGINE, "Volt reconcile");
+        dom::beginPatch();
+        if (m_pCurrentVTree == nullptr) {
+            // Initial render: create DOM from scratch
+            VoltDiffPatch::rebuild(m_idManager, m_focusManager, pNewVTree, m_hHostElement);
+        } else {
+            // Reconcile the prev and new trees, then patch the DOM
+            VoltDiffPatch::diffPatch(m_idManager, m_focusManager, m_pCurrentVTree, pNewVTree, m_hHostElement);
+        }
+        dom::commitPatch(); // Applies the recorded patch in one step, when VOLT_ENABLE_PATCH_BUFFER is set
+        m_focusManager.onDiffDone();
     }
 
+#ifdef VOLT_ENABLE_VERIFY
+    // Debug aid: catch reconciliation bugs right at the frame that caused them
+    int nMismatches = VoltDiffPatch::verify(pNewVTree, m_hHostElement);
+    if (nMismatches > 0) {
+        emscripten_log(EM_LOG_ERROR, "Volt: DOM does not match the VTree after patch (%d mismatches)", nMismatches);
+        VOLT_DEBUG("Volt>DiffPatch>Verify", "expected markup: " + pNewVTree->toHtml());
+    }
+#endif
+
     std::string duplicateKeyDescription = m_idManager.getDuplicateKeyDescription();
     if (!duplicateKeyDescription.empty()) {
         emscripten_log(EM_LOG_WARN, "Volt: Duplicate keys detected:\n%s", duplicateKeyDescription.c_str());
@@ -125,6 +226,8 @@ void VoltEngine::doRender() {
 
     m_pCurrentVTree = pNewVTree;
     //m_idManager.toString();
+
+    VOLT_PROFILE_FRAME_END(m_sModuleName);
 }
 
 } // namespace volt
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <type_traits>
+
+// Arguments one fmt() call can take, each costs 9 bytes in every VNode
+#ifndef VOLT_FORMAT_MAX_ARGS
+#define VOLT_FORMAT_MAX_ARGS 4
+#endif
+
+// Size of a TextArena block, the formatted text of a frame usually fits the first one
+#ifndef VOLT_TEXT_ARENA_BLOCK
+#define VOLT_TEXT_ARENA_BLOCK 16384
+#endif
+
+namespace volt {
+
+// ============================================================================
+// Format - Text node content kept as numbers until it is written
+// ============================================================================
+// tag::td(nCount), tag::td(nRatio) and tag::p(volt::fmt("Counter: {}", nCount))
+// build text nodes that hold the format literal and the raw numbers. The diff
+// compares those, and only a changed value is formatted, into the TextArena:
+// a grid of unchanged numbers neither allocates nor formats anything.
+//
+// Placeholders: {} (integer, shortest round-trip double), {:.2f} (fixed
+// precision), {{ and }} for braces. The node keeps the format pointer across
+// frames, so it must be a string literal: see FormatLiteral.
+
+// Format text with static storage. The constructor is consteval, only a constant
+// expression converts: a literal does, a std::string's c_str() or a stack buffer fails to compile.
+class FormatLiteral {
+public:
+    consteval FormatLiteral(const char* a_sFormat) : m_sFormat(a_sFormat) {}
+
+    const char* c_str() const { return m_sFormat; }
+
+private:
+    const char* m_sFormat;
+};
+
+class Format {
+public:
+    Format() = default;
+
+    template<typename... Args>
+    explicit Format(FormatLiteral a_format, Args... a_args) : m_sFormat(a_format.c_str()), m_nArgs(sizeof...(Args)) {
+        static_assert(sizeof...(Args) <= VOLT_FORMAT_MAX_ARGS, "volt::fmt: too many arguments, raise VOLT_FORMAT_MAX_ARGS");
+        size_t nIdx = 0;
+        (setArg(nIdx++, a_args), ...);
+    }
+
+    // Same literal (or same format text) and bit-identical arguments
+    bool operator==(const Format& a_other) const;
+
+    void appendTo(std::string& a_sText) const;
+
+private:
+    enum class EKind : uint8_t { INT, UINT, DOUBLE };
+
+    template<typename T>
+    void setArg(size_t a_nIdx, T a_value) {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "volt::fmt: arguments must be numbers");
+        if constexpr (std::is_floating_point_v<T>) {
+            double nValue = static_cast<double>(a_value);
+            std::memcpy(&m_args[a_nIdx], &nValue, sizeof(nValue));
+            m_kinds[a_nIdx] = EKind::DOUBLE;
+        } else if constexpr (std::is_signed_v<T>) {
+            m_args[a_nIdx] = static_cast<uint64_t>(static_cast<int64_t>(a_value));
+            m_kinds[a_nIdx] = EKind::INT;
+        } else {
+            m_args[a_nIdx] = static_cast<uint64_t>(a_value);
+            m_kinds[a_nIdx] = EKind::UINT;
+        }
+    }
+
+    void appendArg(std::string& a_sText, size_t a_nIdx, int a_nPrecision) const;
+
+    const char* m_sFormat = "";
+    uint64_t m_args[VOLT_FORMAT_MAX_ARGS] = {}; // Bits of the int64_t / uint64_t / double
+    EKind m_kinds[VOLT_FORMAT_MAX_ARGS] = {};
+    uint8_t m_nArgs = 0;
+};
+
+// Text node content, see Format
+template<typename... Args>
+inline Format fmt(FormatLiteral a_format, Args... a_args) {
+    return Format(a_format, a_args...);
+}
+
+// ============================================================================
+// TextArena - Frame scoped storage of formatted text
+// ============================================================================
+// Reset at the start of each render. Blocks are kept from frame to frame,
+// so after the first frames formatting allocates nothing.
+
+class TextArena {
+public:
+    // Module wide instance, shared by all engines on this thread
+    static TextArena&
+                instance                    ();
+
+    // Formats into the arena. The view is NUL-terminated and valid until reset().
+    std::string_view
+                write                       (const Format& a_format);
+
+    // Copies into the arena, same lifetime
+    std::string_view
+                write                       (std::string_view a_sText);
+
+    // Drops every view handed out, keeps the blocks
+    void        reset                       () { m_nBlock = 0; m_nUsed = 0; ++m_nEpoch; }
+
+    // Changes with every reset(), views of an older epoch must be formatted again
+    uint32_t    getEpoch                    () const { return m_nEpoch; }
+
+private:
+    char*       allocate                    (size_t a_nSize);
+
+    struct Block {
+        std::unique_ptr<char[]> pBytes;
+        size_t      nSize;
+    };
+
+    std::vector<Block>
+                m_blocks;
+    std::string m_sScratch; // Formatting target before the length is known
+    size_t      m_nBlock = 0;
+    size_t      m_nUsed = 0;
+    uint32_t    m_nEpoch = 1;
+};
+
+} // namespace volt
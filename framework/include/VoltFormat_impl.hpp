@@ -0,0 +1,121 @@
+#include "VoltFormat.hpp"
+#include <charconv>
+#include <algorithm>
+
+namespace volt {
+
+// ============================================================================
+// Format Implementation
+// ============================================================================
+
+bool Format::operator==(const Format& a_other) const {
+    if (m_nArgs != a_other.m_nArgs) {
+        return false;
+    }
+    if (m_sFormat != a_other.m_sFormat && std::strcmp(m_sFormat, a_other.m_sFormat) != 0) {
+        return false;
+    }
+    for (uint8_t i = 0; i < m_nArgs; ++i) {
+        if (m_args[i] != a_other.m_args[i] || m_kinds[i] != a_other.m_kinds[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Format::appendTo(std::string& a_sText) const {
+    size_t nArg = 0;
+    const char* p = m_sFormat;
+    while (*p != '\0') {
+        if ((p[0] == '{' && p[1] == '{') || (p[0] == '}' && p[1] == '}')) {
+            a_sText += p[0];
+            p += 2;
+        } else if (p[0] == '{') {
+            // {} or {:.Nf}
+            int nPrecision = -1;
+            const char* pEnd = p + 1;
+            if (pEnd[0] == ':' && pEnd[1] == '.') {
+                pEnd += 2;
+                nPrecision = 0;
+                while (*pEnd >= '0' && *pEnd <= '9') {
+                    nPrecision = nPrecision * 10 + (*pEnd++ - '0');
+                }
+                if (*pEnd == 'f') {
+                    ++pEnd;
+                }
+            }
+            if (*pEnd != '}') {
+                a_sText += *p++; // Not a placeholder, kept as is
+                continue;
+            }
+            if (nArg < m_nArgs) {
+                appendArg(a_sText, nArg++, nPrecision);
+            }
+            p = pEnd + 1;
+        } else {
+            a_sText += *p++;
+        }
+    }
+}
+
+void Format::appendArg(std::string& a_sText, size_t a_nIdx, int a_nPrecision) const {
+    char buffer[352]; // Fits any double in fixed notation
+    std::to_chars_result result{};
+    switch (m_kinds[a_nIdx]) {
+        case EKind::INT:
+            result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<int64_t>(m_args[a_nIdx]));
+            break;
+        case EKind::UINT:
+            result = std::to_chars(buffer, buffer + sizeof(buffer), m_args[a_nIdx]);
+            break;
+        case EKind::DOUBLE: {
+            double nValue;
+            std::memcpy(&nValue, &m_args[a_nIdx], sizeof(nValue));
+            result = a_nPrecision < 0
+                ? std::to_chars(buffer, buffer + sizeof(buffer), nValue)
+                : std::to_chars(buffer, buffer + sizeof(buffer), nValue, std::chars_format::fixed, std::min(a_nPrecision, 17));
+            break;
+        }
+    }
+    a_sText.append(buffer, result.ptr);
+}
+
+// ============================================================================
+// TextArena Implementation
+// ============================================================================
+
+TextArena& TextArena::instance() {
+    thread_local TextArena s_arena;
+    return s_arena;
+}
+
+std::string_view TextArena::write(const Format& a_format) {
+    m_sScratch.clear();
+    a_format.appendTo(m_sScratch);
+    return write(std::string_view(m_sScratch));
+}
+
+std::string_view TextArena::write(std::string_view a_sText) {
+    char* pText = allocate(a_sText.size() + 1);
+    std::memcpy(pText, a_sText.data(), a_sText.size());
+    pText[a_sText.size()] = '\0';
+    return std::string_view(pText, a_sText.size());
+}
+
+char* TextArena::allocate(size_t a_nSize) {
+    // Next kept block that fits, views into earlier blocks stay valid
+    while (m_nBlock < m_blocks.size() && m_nUsed + a_nSize > m_blocks[m_nBlock].nSize) {
+        ++m_nBlock;
+        m_nUsed = 0;
+    }
+    if (m_nBlock == m_blocks.size()) {
+        size_t nSize = std::max<size_t>(VOLT_TEXT_ARENA_BLOCK, a_nSize);
+        m_blocks.push_back(Block{std::make_unique<char[]>(nSize), nSize});
+        m_nUsed = 0;
+    }
+    char* pBytes = m_blocks[m_nBlock].pBytes.get() + m_nUsed;
+    m_nUsed += a_nSize;
+    return pBytes;
+}
+
+} // namespace volt
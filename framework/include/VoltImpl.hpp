@@ -2,8 +2,14 @@
 
 #include "Tags_impl.hpp"
 #include "DOM_impl.hpp"
+#include "VoltFormat_impl.hpp"
+#include "VoltPatch_impl.hpp"
 #include "IdManager_impl.hpp"
+#include "VNodeTable_impl.hpp"
+#include "FocusManager_impl.hpp"
 #include "VoltEngine_impl.hpp"
+#include "VoltScheduler_impl.hpp"
+#include "VoltAnimated_impl.hpp"
 #include "VNodeHandle_impl.hpp"
 #include "VoltDiffPatch_impl.hpp"
 #include "VNode_impl.hpp"
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <stdint.h>
+#include <emscripten.h>
+#include <emscripten/val.h>
+#include "InplaceFunction.hpp"
+
+// Bridge from C++ to JS: hands one serialized patch to volt.js (volt._applyPatch), see EPatchOp
+// for the records. With MEMORY64 pointers arrive as BigInt and may lie above 2^31: Number() and
+// a division, never >> 2. Handles are uint32 Emval ids, names are ids into Module.__voltPatchNames.
+// When Module.voltPostPatch is set (render on a worker) the patch is copied into transferable
+// buffers and passed to it instead, the receiving thread applies it with volt._applyPatch.
+EM_JS(void, volt_js_apply_patch,
+      (const int32_t* ops, int count, const uint32_t* handles, int handleCount, const char* strings, int stringLength),
+{
+    const opBase = Number(ops) / 4;
+    const handleBase = Number(handles) / 4;
+    const stringBase = Number(strings);
+    const patch = {
+        ops: HEAP32.subarray(opBase, opBase + count),
+        handles: HEAPU32.subarray(handleBase, handleBase + handleCount),
+        strings: HEAPU8.subarray(stringBase, stringBase + stringLength),
+        names: Module.__voltPatchNames || [],
+    };
+    if (typeof Module.voltPostPatch === 'function') {
+        Module.voltPostPatch({
+            ops: patch.ops.slice(),
+            handles: patch.handles.slice(),
+            strings: patch.strings.slice(),
+            names: patch.names.slice(),
+        });
+        return;
+    }
+    if (typeof window !== 'undefined' &&
+        window.volt &&
+        typeof window.volt._applyPatch === 'function') {
+        window.volt._applyPatch(patch, (id) => Emval.toValue(id));
+    } else {
+        console.error("Volt: volt.js is not loaded, patch dropped");
+    }
+});
+
+// Names of the patch records, registered once per thread and id
+EM_JS(void, volt_js_register_patch_name, (int id, const char* name), {
+    (Module.__voltPatchNames || (Module.__voltPatchNames = []))[id] = UTF8ToString(Number(name));
+});
+
+
+namespace volt {
+
+    // Records of a serialized patch, int32 each: opcode then operands.
+    // el/parent/child/ref/style/classList are handle indexes, name is a name id (attribute id * 2,
+    // + 1 for the property name), str is (offset, length) into the string arena, value a handle
+    // index of a volt::String. Opcodes must match volt._applyPatch in volt.js.
+    enum class EPatchOp : int32_t {
+        SET_ATTRIBUTE         = 1,  // el, name, str
+        SET_PROPERTY          = 2,  // el, name, str       (skipped when the live value matches)
+        SET_BOOL_PROPERTY     = 3,  // el, name, bool
+        TOGGLE_ATTRIBUTE      = 4,  // el, name, bool
+        SET_CSS_TEXT          = 5,  // el, str
+        REMOVE_ATTRIBUTE      = 6,  // el, name
+        SET_STYLE_PROPERTY    = 7,  // style, str, str
+        REMOVE_STYLE_PROPERTY = 8,  // style, str
+        ADD_CLASS             = 9,  // classList, str
+        REMOVE_CLASS          = 10, // classList, str
+        SET_NODE_VALUE        = 11, // el, str
+        APPEND_CHILD          = 12, // parent, child
+        INSERT_BEFORE         = 13, // parent, child, ref
+        REMOVE_CHILD          = 14, // parent, child
+        ADD_EVENT_LISTENER    = 15, // el, name, handler
+        REMOVE_EVENT_LISTENER = 16, // el, name, handler
+        SET_ATTRIBUTE_VALUE   = 17, // el, name, value
+        SET_PROPERTY_VALUE    = 18, // el, name, value     (skipped when the live value matches)
+        SET_CSS_TEXT_VALUE    = 19, // el, value
+        SET_NODE_VALUE_VALUE  = 20, // el, value
+        SET_NUMBER_PROPERTY   = 21, // el, name, str       (Number(str), skipped when the live number matches)
+    };
+
+    // DOM writes of one frame, serialized into plain ints and UTF-8 and applied by a
+    // single JS call. Reads (createElement, style/classList lookups) stay immediate.
+    class PatchBuffer {
+    public:
+        void setAttribute(const emscripten::val& a_hElement, short a_nAttrId, const std::string& a_sValue);
+        void setAttribute(const emscripten::val& a_hElement, short a_nAttrId, const emscripten::val& a_hValue);
+        void removeAttribute(const emscripten::val& a_hElement, short a_nAttrId);
+        void addEventListener(const emscripten::val& a_hElement, short a_nEventId, const emscripten::val& a_hHandler);
+        void removeEventListener(const emscripten::val& a_hElement, short a_nEventId, const emscripten::val& a_hHandler);
+        void setStyleProperty(const emscripten::val& a_hStyle, std::string_view a_sProperty, std::string_view a_sValue);
+        void removeStyleProperty(const emscripten::val& a_hStyle, std::string_view a_sProperty);
+        void addClass(const emscripten::val& a_hClassList, std::string_view a_sToken);
+        void removeClass(const emscripten::val& a_hClassList, std::string_view a_sToken);
+        void setNodeValue(const emscripten::val& a_hTextNode, std::string_view a_sText);
+        void setNodeValue(const emscripten::val& a_hTextNode, const emscripten::val& a_hText);
+        void appendChild(const emscripten::val& a_hParent, const emscripten::val& a_hChild);
+        void insertBefore(const emscripten::val& a_hParent, const emscripten::val& a_hChild, const emscripten::val& a_hReference);
+        void removeChild(const emscripten::val& a_hParent, const emscripten::val& a_hChild);
+
+        // Runs once the patch is applied, e.g. lifecycle hooks that expect the element in the document
+        void afterCommit(InplaceFunction<void()> a_fn) { m_afterCommit.push_back(std::move(a_fn)); }
+
+        // Applies the recorded patch, then the after-commit callbacks. Buffers keep their capacity.
+        void flush();
+
+        bool empty() const { return m_ops.empty() && m_afterCommit.empty(); }
+
+    private:
+        int32_t handle(const emscripten::val& a_hValue);
+        void op(EPatchOp a_nOp) { m_ops.push_back(static_cast<int32_t>(a_nOp)); }
+        void name(short a_nAttrId, bool a_bProperty);
+        void str(std::string_view a_sValue);
+
+        std::vector<int32_t> m_ops;
+        std::vector<emscripten::val> m_handles; // Keeps the handles alive until the patch is applied
+        std::vector<uint32_t> m_rawHandles;     // Their Emval ids, 4 bytes each on wasm32 and MEMORY64
+        std::string m_strings;
+        std::vector<InplaceFunction<void()>> m_afterCommit;
+    };
+
+} // namespace volt
@@ -0,0 +1,256 @@
+#include "VoltPatch.hpp"
+#include "Attrs.hpp"
+#include "VoltProfiler.hpp"
+
+namespace volt {
+
+// ============================================================================
+// PatchBuffer Implementation
+// ============================================================================
+
+int32_t PatchBuffer::handle(const emscripten::val& a_hValue) {
+    // Writes to one element come in a row, they share its handle slot
+    uint32_t hRaw = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(a_hValue.as_handle()));
+    if (!m_rawHandles.empty() && m_rawHandles.back() == hRaw) {
+        return static_cast<int32_t>(m_rawHandles.size() - 1);
+    }
+    m_handles.push_back(a_hValue);
+    m_rawHandles.push_back(hRaw);
+    return static_cast<int32_t>(m_rawHandles.size() - 1);
+}
+
+void PatchBuffer::name(short a_nAttrId, bool a_bProperty) {
+    // Ids without a name share the last slot, as in dom::attrName()
+    size_t nAttr = (a_nAttrId >= 0 && a_nAttrId < attr::ATTR_NAMED_END) ? a_nAttrId : attr::ATTR_NAMED_END;
+    size_t nId = nAttr * 2 + (a_bProperty ? 1 : 0);
+
+    thread_local std::vector<bool> s_registered((attr::ATTR_NAMED_END + 1) * 2, false);
+    if (!s_registered[nId]) {
+        volt_js_register_patch_name(static_cast<int>(nId), a_bProperty ? attr::attrPropertyNameOf(a_nAttrId) : attr::attrIdToName(a_nAttrId));
+        s_registered[nId] = true;
+    }
+    m_ops.push_back(static_cast<int32_t>(nId));
+}
+
+void PatchBuffer::str(std::string_view a_sValue) {
+    m_ops.push_back(static_cast<int32_t>(m_strings.size()));
+    m_ops.push_back(static_cast<int32_t>(a_sValue.size()));
+    m_strings.append(a_sValue);
+}
+
+// Same strategies as dom::setAttribute(), the live value compare moves to the JS side
+void PatchBuffer::setAttribute(const emscripten::val& a_hElement, short a_nAttrId, const std::string& a_sValue) {
+    VOLT_PROFILE_COUNT(attrsSet);
+    int32_t nElement = handle(a_hElement);
+    switch (attr::attrWrite(a_nAttrId)) {
+        case attr::EAttrWrite::PROPERTY:
+            op(EPatchOp::SET_PROPERTY);
+            m_ops.push_back(nElement);
+            name(a_nAttrId, true);
+            str(a_sValue);
+            break;
+        case attr::EAttrWrite::NUMBER_PROPERTY:
+            op(EPatchOp::SET_NUMBER_PROPERTY);
+            m_ops.push_back(nElement);
+            name(a_nAttrId, true);
+            str(a_sValue);
+            break;
+        case attr::EAttrWrite::BOOL_PROPERTY:
+            op(EPatchOp::SET_BOOL_PROPERTY);
+            m_ops.push_back(nElement);
+            name(a_nAttrId, true);
+            m_ops.push_back(a_sValue != "false");
+            break;
+        case attr::EAttrWrite::BOOL_ATTRIBUTE:
+            op(EPatchOp::TOGGLE_ATTRIBUTE);
+            m_ops.push_back(nElement);
+            name(a_nAttrId, false);
+            m_ops.push_back(a_sValue != "false");
+            break;
+        case attr::EAttrWrite::STYLE:
+            op(EPatchOp::SET_CSS_TEXT);
+            m_ops.push_back(nElement);
+            str(a_sValue);
+            break;
+        default:
+            op(EPatchOp::SET_ATTRIBUTE);
+            m_ops.push_back(nElement);
+            name(a_nAttrId, false);
+            str(a_sValue);
+            break;
+    }
+}
+
+void PatchBuffer::setAttribute(const emscripten::val& a_hElement, short a_nAttrId, const emscripten::val& a_hValue) {
+    attr::EAttrWrite nWrite = attr::attrWrite(a_nAttrId);
+    if (nWrite == attr::EAttrWrite::NUMBER_PROPERTY || nWrite == attr::EAttrWrite::BOOL_PROPERTY || nWrite == attr::EAttrWrite::BOOL_ATTRIBUTE) {
+        setAttribute(a_hElement, a_nAttrId, a_hValue.as<std::string>()); // Same as dom::setAttribute(), a number or "false"
+        return;
+    }
+
+    VOLT_PROFILE_COUNT(attrsSet);
+    int32_t nElement = handle(a_hElement);
+    int32_t nValue = handle(a_hValue);
+    switch (nWrite) {
+        case attr::EAttrWrite::PROPERTY:
+            op(EPatchOp::SET_PROPERTY_VALUE);
+            m_ops.push_back(nElement);
+            name(a_nAttrId, true);
+            m_ops.push_back(nValue);
+            break;
+        case attr::EAttrWrite::STYLE:
+            op(EPatchOp::SET_CSS_TEXT_VALUE);
+            m_ops.push_back(nElement);
+            m_ops.push_back(nValue);
+            break;
+        default:
+            op(EPatchOp::SET_ATTRIBUTE_VALUE);
+            m_ops.push_back(nElement);
+            name(a_nAttrId, false);
+            m_ops.push_back(nValue);
+            break;
+    }
+}
+
+void PatchBuffer::removeAttribute(const emscripten::val& a_hElement, short a_nAttrId) {
+    int32_t nElement = handle(a_hElement);
+    switch (attr::attrWrite(a_nAttrId)) {
+        case attr::EAttrWrite::PROPERTY:
+            op(EPatchOp::SET_PROPERTY);
+            m_ops.push_back(nElement);
+            name(a_nAttrId, true);
+            str(std::string());
+            break;
+        case attr::EAttrWrite::NUMBER_PROPERTY:
+            op(EPatchOp::SET_NUMBER_PROPERTY);
+            m_ops.push_back(nElement);
+            name(a_nAttrId, true);
+            str("0");
+            break;
+        case attr::EAttrWrite::BOOL_PROPERTY:
+            op(EPatchOp::SET_BOOL_PROPERTY);
+            m_ops.push_back(nElement);
+            name(a_nAttrId, true);
+            m_ops.push_back(0);
+            break;
+        default:
+            op(EPatchOp::REMOVE_ATTRIBUTE);
+            m_ops.push_back(nElement);
+            name(a_nAttrId, false);
+            break;
+    }
+}
+
+void PatchBuffer::addEventListener(const emscripten::val& a_hElement, short a_nEventId, const emscripten::val& a_hHandler) {
+    int32_t nElement = handle(a_hElement);
+    int32_t nHandler = handle(a_hHandler);
+    op(EPatchOp::ADD_EVENT_LISTENER);
+    m_ops.push_back(nElement);
+    name(a_nEventId, false);
+    m_ops.push_back(nHandler);
+}
+
+void PatchBuffer::removeEventListener(const emscripten::val& a_hElement, short a_nEventId, const emscripten::val& a_hHandler) {
+    int32_t nElement = handle(a_hElement);
+    int32_t nHandler = handle(a_hHandler);
+    op(EPatchOp::REMOVE_EVENT_LISTENER);
+    m_ops.push_back(nElement);
+    name(a_nEventId, false);
+    m_ops.push_back(nHandler);
+}
+
+void PatchBuffer::setStyleProperty(const emscripten::val& a_hStyle, std::string_view a_sProperty, std::string_view a_sValue) {
+    int32_t nStyle = handle(a_hStyle);
+    op(EPatchOp::SET_STYLE_PROPERTY);
+    m_ops.push_back(nStyle);
+    str(a_sProperty);
+    str(a_sValue);
+}
+
+void PatchBuffer::removeStyleProperty(const emscripten::val& a_hStyle, std::string_view a_sProperty) {
+    int32_t nStyle = handle(a_hStyle);
+    op(EPatchOp::REMOVE_STYLE_PROPERTY);
+    m_ops.push_back(nStyle);
+    str(a_sProperty);
+}
+
+void PatchBuffer::addClass(const emscripten::val& a_hClassList, std::string_view a_sToken) {
+    int32_t nClassList = handle(a_hClassList);
+    op(EPatchOp::ADD_CLASS);
+    m_ops.push_back(nClassList);
+    str(a_sToken);
+}
+
+void PatchBuffer::removeClass(const emscripten::val& a_hClassList, std::string_view a_sToken) {
+    int32_t nClassList = handle(a_hClassList);
+    op(EPatchOp::REMOVE_CLASS);
+    m_ops.push_back(nClassList);
+    str(a_sToken);
+}
+
+void PatchBuffer::setNodeValue(const emscripten::val& a_hTextNode, std::string_view a_sText) {
+    int32_t nTextNode = handle(a_hTextNode);
+    op(EPatchOp::SET_NODE_VALUE);
+    m_ops.push_back(nTextNode);
+    str(a_sText);
+}
+
+void PatchBuffer::setNodeValue(const emscripten::val& a_hTextNode, const emscripten::val& a_hText) {
+    int32_t nTextNode = handle(a_hTextNode);
+    int32_t nText = handle(a_hText);
+    op(EPatchOp::SET_NODE_VALUE_VALUE);
+    m_ops.push_back(nTextNode);
+    m_ops.push_back(nText);
+}
+
+void PatchBuffer::appendChild(const emscripten::val& a_hParent, const emscripten::val& a_hChild) {
+    int32_t nParent = handle(a_hParent);
+    int32_t nChild = handle(a_hChild);
+    op(EPatchOp::APPEND_CHILD);
+    m_ops.push_back(nParent);
+    m_ops.push_back(nChild);
+}
+
+void PatchBuffer::insertBefore(const emscripten::val& a_hParent, const emscripten::val& a_hChild, const emscripten::val& a_hReference) {
+    int32_t nParent = handle(a_hParent);
+    int32_t nChild = handle(a_hChild);
+    int32_t nReference = handle(a_hReference);
+    op(EPatchOp::INSERT_BEFORE);
+    m_ops.push_back(nParent);
+    m_ops.push_back(nChild);
+    m_ops.push_back(nReference);
+}
+
+void PatchBuffer::removeChild(const emscripten::val& a_hParent, const emscripten::val& a_hChild) {
+    int32_t nParent = handle(a_hParent);
+    int32_t nChild = handle(a_hChild);
+    op(EPatchOp::REMOVE_CHILD);
+    m_ops.push_back(nParent);
+    m_ops.push_back(nChild);
+}
+
+void PatchBuffer::flush() {
+    VOLT_PROFILE_SCOPE(commitMs);
+
+    if (!m_ops.empty()) {
+        volt_js_apply_patch(
+            m_ops.data(), static_cast<int>(m_ops.size()),
+            m_rawHandles.data(), static_cast<int>(m_rawHandles.size()),
+            m_strings.data(), static_cast<int>(m_strings.size()));
+    }
+    m_ops.clear();
+    m_handles.clear();
+    m_rawHandles.clear();
+    m_strings.clear();
+
+    // Callbacks may render into the DOM directly, but must not record into this buffer
+    std::vector<InplaceFunction<void()>> afterCommit;
+    afterCommit.swap(m_afterCommit);
+    for (auto& fn : afterCommit) {
+        fn();
+    }
+    afterCommit.clear();
+    m_afterCommit.swap(afterCommit);
+}
+
+} // namespace volt
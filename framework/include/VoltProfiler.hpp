@@ -0,0 +1,135 @@
+#pragma once
+
+#include <string>
+#include <stdint.h>
+#include <emscripten.h>
+
+// Bridge from C++ to JS volt console, one call per finished frame
+EM_JS(void, volt_js_profile_frame,
+      (const char* module, double timestamp,
+       double renderMs, double buildMs, double walkMs, double commitMs, double totalMs,
+       int nodesCreated, int nodesReused, int nodesMoved, int nodesRemoved,
+       int textsUpdated, int attrsSet, int attrsRemoved, int listenersAdded, int listenersRemoved),
+{
+    if (typeof window !== 'undefined' &&
+        window.volt &&
+        typeof window.volt._recordFrame === 'function') {
+
+        window.volt._recordFrame({
+            module: UTF8ToString(Number(module)),
+            timestamp: timestamp,
+            renderMs: renderMs,
+            buildMs: buildMs,
+            walkMs: walkMs,
+            commitMs: commitMs,
+            totalMs: totalMs,
+            nodesCreated: nodesCreated,
+            nodesReused: nodesReused,
+            nodesMoved: nodesMoved,
+            nodesRemoved: nodesRemoved,
+            textsUpdated: textsUpdated,
+            attrsSet: attrsSet,
+            attrsRemoved: attrsRemoved,
+            listenersAdded: listenersAdded,
+            listenersRemoved: listenersRemoved,
+        });
+    }
+});
+
+
+namespace volt {
+
+    // Per-frame measurements. Times are exclusive: renderMs does not include
+    // buildMs (VNode construction happens inside App::render), and walkMs does
+    // not include commitMs (DOM calls happen inside the walk).
+    struct FrameStats {
+        double      timestamp = 0;
+        double      renderMs = 0;
+        double      buildMs = 0;
+        double      walkMs = 0;
+        double      commitMs = 0;
+        double      totalMs = 0;
+        uint32_t    nodesCreated = 0;
+        uint32_t    nodesReused = 0;
+        uint32_t    nodesMoved = 0;
+        uint32_t    nodesRemoved = 0;
+        uint32_t    textsUpdated = 0;
+        uint32_t    attrsSet = 0;
+        uint32_t    attrsRemoved = 0;
+        uint32_t    listenersAdded = 0;
+        uint32_t    listenersRemoved = 0;
+    };
+
+#ifdef VOLT_ENABLE_PROFILER
+
+    // Stats of the frame being rendered, set by VoltEngine only during doRender()
+    inline thread_local FrameStats* g_pFrameStats = nullptr;
+
+    inline void profileFrameBegin(FrameStats& a_stats) noexcept {
+        a_stats = FrameStats();
+        a_stats.timestamp = emscripten_get_now();
+        g_pFrameStats = &a_stats;
+    }
+
+    inline void profileFrameEnd(const std::string& a_sModuleName) noexcept {
+        FrameStats& stats = *g_pFrameStats;
+        g_pFrameStats = nullptr;
+
+        stats.totalMs = emscripten_get_now() - stats.timestamp;
+        stats.renderMs -= stats.buildMs;
+        stats.walkMs -= stats.commitMs;
+
+        volt_js_profile_frame(
+            a_sModuleName.c_str(), stats.timestamp,
+            stats.renderMs, stats.buildMs, stats.walkMs, stats.commitMs, stats.totalMs,
+            stats.nodesCreated, stats.nodesReused, stats.nodesMoved, stats.nodesRemoved,
+            stats.textsUpdated, stats.attrsSet, stats.attrsRemoved,
+            stats.listenersAdded, stats.listenersRemoved);
+    }
+
+    // Adds the elapsed time of its lifetime to one FrameStats field
+    class ProfileScope {
+    public:
+        explicit ProfileScope(double FrameStats::* a_pField) noexcept
+            : m_pField(a_pField), m_nStart(g_pFrameStats ? emscripten_get_now() : 0) {}
+
+        ~ProfileScope() {
+            if (g_pFrameStats) {
+                g_pFrameStats->*m_pField += emscripten_get_now() - m_nStart;
+            }
+        }
+    private:
+        double FrameStats::* m_pField;
+        double m_nStart;
+    };
+
+#endif // VOLT_ENABLE_PROFILER
+
+} // namespace volt
+
+// ---- Public macros --------------------------------------------------------
+
+#ifdef VOLT_ENABLE_PROFILER
+
+    #define VOLT_PROFILE_CONCAT_IMPL(a, b) a##b
+    #define VOLT_PROFILE_CONCAT(a, b) VOLT_PROFILE_CONCAT_IMPL(a, b)
+
+    #define VOLT_PROFILE_FRAME_BEGIN(stats)            ::volt::profileFrameBegin(stats)
+    #define VOLT_PROFILE_FRAME_END(moduleName)         ::volt::profileFrameEnd(moduleName)
+
+    #define VOLT_PROFILE_SCOPE(field) \
+        ::volt::ProfileScope VOLT_PROFILE_CONCAT(volt_profile_scope_, __LINE__)(&::volt::FrameStats::field)
+
+    #define VOLT_PROFILE_COUNT(field) \
+        do { if (::volt::g_pFrameStats) { ++::volt::g_pFrameStats->field; } } while (0)
+
+#else
+
+    // Fully zero-cost when disabled: macros compile to nothing.
+
+    #define VOLT_PROFILE_FRAME_BEGIN(stats)            do {} while (0)
+    #define VOLT_PROFILE_FRAME_END(moduleName)         do {} while (0)
+    #define VOLT_PROFILE_SCOPE(field)                  do {} while (0)
+    #define VOLT_PROFILE_COUNT(field)                  do {} while (0)
+
+#endif
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <emscripten.h>
+#include <emscripten/html5.h>
+#include <vector>
+#include "VoltTask.hpp"
+
+// Time the scheduler may spend rendering engines in one animation frame.
+// At least one engine always renders, the rest wait for the next frame.
+#ifndef VOLT_FRAME_BUDGET_MS
+#define VOLT_FRAME_BUDGET_MS 8.0
+#endif
+
+namespace volt {
+
+class VoltEngine;
+class AnimatedBase;
+
+// ============================================================================
+// VoltScheduler - One animation frame for every engine in the module
+// ============================================================================
+
+class VoltScheduler {
+public:
+    // Module wide instance, shared by all engines on this thread
+    static VoltScheduler& 
+                instance                    ();
+
+    // Queue an engine for the next frame, called by VoltEngine::invalidate()
+    void        schedule                    (VoltEngine* a_pEngine);
+
+    // Drop an engine from every queue, called by ~VoltEngine()
+    void        unschedule                  (VoltEngine* a_pEngine);
+
+    // Queue a suspended task on a lane, called by the awaitables
+    void        enqueueTask                 (ETaskLane a_nLane, Task::Handle a_handle, double a_nBudgetMs);
+
+    // Resume the tasks queued on a lane, a_nAvailableMs is the idle time left (IDLE only).
+    // Called from JS through runScheduledTasks() and from the animation frame.
+    void        runTasks                    (ETaskLane a_nLane, double a_nAvailableMs);
+
+    // Step an Animated in every frame until it settles, called by the Animated itself
+    void        startAnimation              (AnimatedBase* a_pAnimated);
+
+    // Stop stepping it, called by ~AnimatedBase()
+    void        stopAnimation               (AnimatedBase* a_pAnimated);
+
+    // Render every invalidated engine now, by priority, see volt::flushSync()
+    void        flushSync                   ();
+
+    // Rendering time allowed per frame, in milliseconds
+    void        setFrameBudget              (double a_nBudgetMs) { m_nFrameBudgetMs = a_nBudgetMs; }
+    double      getFrameBudget              () const { return m_nFrameBudgetMs; }
+
+private:
+    // Render loop callback
+    static EM_BOOL 
+                onAnimationFrame            (double a_nTimestamp, void* a_pThisAsVoidStar);
+
+    // Render queued engines by priority until the budget is spent
+    void        runFrame                    ();
+
+    void        requestFrame                ();
+
+    // Advance every running Animated, before the engines render
+    void        stepAnimations              (double a_nTimestamp);
+
+    // Ask JS to call runTasks() for a lane
+    void        requestLane                 (ETaskLane a_nLane);
+
+    // Destroy the suspended tasks of an engine, called by unschedule()
+    void        cancelTasks                 (VoltEngine* a_pEngine);
+
+    // MEMBERS
+
+    // Engines invalidated since the last frame, in invalidation order
+    std::vector<VoltEngine*> 
+                m_pending;
+
+    // Engines that did not fit the last frame's budget, they go first next frame
+    std::vector<VoltEngine*> 
+                m_deferred;
+
+    // Engines of the frame being rendered, destroyed ones are set to nullptr
+    std::vector<VoltEngine*> 
+                m_running;
+
+    struct QueuedTask {
+        Task::Handle handle;
+        double      nBudgetMs;
+    };
+
+    // Suspended tasks per lane, in suspension order
+    std::vector<QueuedTask>
+                m_tasks[3];
+
+    // Tasks of the lane being run, cancelled ones are set to nullptr
+    std::vector<QueuedTask>
+                m_runningTasks;
+
+    // Animated values in motion, or with a value still to write
+    std::vector<AnimatedBase*>
+                m_animations;
+
+    bool        m_bTaskPosted = false;
+    bool        m_bIdleRequested = false;
+    bool        m_bFrameRequested = false;
+    double      m_nFrameBudgetMs = VOLT_FRAME_BUDGET_MS;
+};
+
+} // namespace volt
@@ -0,0 +1,245 @@
+#include "VoltScheduler.hpp"
+#include "VoltEngine.hpp"
+#include <algorithm>
+
+namespace volt {
+
+// ============================================================================
+// VoltScheduler Implementation
+// ============================================================================
+
+VoltScheduler& VoltScheduler::instance() {
+    thread_local VoltScheduler s_scheduler;
+    return s_scheduler;
+}
+
+void VoltScheduler::schedule(VoltEngine* a_pEngine) {
+    m_pending.push_back(a_pEngine);
+    requestFrame();
+}
+
+void VoltScheduler::unschedule(VoltEngine* a_pEngine) {
+    m_pending.erase(std::remove(m_pending.begin(), m_pending.end(), a_pEngine), m_pending.end());
+    m_deferred.erase(std::remove(m_deferred.begin(), m_deferred.end(), a_pEngine), m_deferred.end());
+    std::replace(m_running.begin(), m_running.end(), a_pEngine, static_cast<VoltEngine*>(nullptr));
+    cancelTasks(a_pEngine);
+}
+
+void VoltScheduler::flushSync() {
+    if (g_pRenderingEngine != nullptr || !m_running.empty()) {
+        return; // Never a render inside a render, e.g. a blur fired by removing the focused element
+    }
+
+    // The requested animation frame stays, it finds nothing left to render
+    m_running.swap(m_deferred);
+    m_running.insert(m_running.end(), m_pending.begin(), m_pending.end());
+    m_pending.clear();
+    m_deferred.clear();
+    std::stable_sort(m_running.begin(), m_running.end(), [](VoltEngine* a_pA, VoltEngine* a_pB) {
+        return a_pA->getPriority() > a_pB->getPriority();
+    });
+    for (size_t nIdx = 0; nIdx < m_running.size(); ++nIdx) {
+        if (m_running[nIdx] != nullptr) {
+            m_running[nIdx]->onFrame();
+        }
+    }
+    m_running.clear();
+}
+
+void VoltScheduler::requestFrame() {
+    if (m_bFrameRequested) {
+        return; // Already requested
+    }
+
+    m_bFrameRequested = true;
+
+    // One rAF callback for all engines
+    emscripten_request_animation_frame(onAnimationFrame, this);
+}
+
+EM_BOOL VoltScheduler::onAnimationFrame(double a_nTimestamp, void* a_pThisAsVoidStar) {
+    auto* pScheduler = static_cast<VoltScheduler*>(a_pThisAsVoidStar);
+
+    // nextFrame() tasks first, what they invalidate renders in this frame
+    pScheduler->runTasks(ETaskLane::USER_BLOCKING, 0);
+
+    pScheduler->m_bFrameRequested = false; // Invalidations from now on go to the next frame
+    pScheduler->stepAnimations(a_nTimestamp);
+    pScheduler->runFrame();
+
+    if (!pScheduler->m_tasks[static_cast<int>(ETaskLane::USER_BLOCKING)].empty() || !pScheduler->m_animations.empty()) {
+        pScheduler->requestFrame(); // Tasks that awaited nextFrame() again, animations still moving
+    }
+
+    return EM_FALSE; // Don't repeat automatically
+}
+
+void VoltScheduler::runFrame() {
+    double nFrameStart = emscripten_get_now();
+
+    // Deferred engines first, so a low priority engine can't starve,
+    // then this frame's invalidations by priority, ties in invalidation order
+    std::stable_sort(m_pending.begin(), m_pending.end(), [](VoltEngine* a_pA, VoltEngine* a_pB) {
+        return a_pA->getPriority() > a_pB->getPriority();
+    });
+    m_running.swap(m_deferred);
+    m_running.insert(m_running.end(), m_pending.begin(), m_pending.end());
+    m_pending.clear();
+    m_deferred.clear();
+
+    size_t nIdx = 0;
+    bool bRendered = false;
+    for (; nIdx < m_running.size(); ++nIdx) {
+        if (bRendered && emscripten_get_now() - nFrameStart >= m_nFrameBudgetMs) {
+            break; // Budget spent, the rest waits for the next frame
+        }
+        if (m_running[nIdx] != nullptr) { // nullptr: destroyed during this frame
+            m_running[nIdx]->onFrame();
+            bRendered = true;
+        }
+    }
+
+    for (; nIdx < m_running.size(); ++nIdx) {
+        if (m_running[nIdx] != nullptr) {
+            m_deferred.push_back(m_running[nIdx]);
+        }
+    }
+    m_running.clear();
+
+    if (!m_deferred.empty()) {
+        requestFrame();
+    }
+}
+
+// ============================================================================
+// Tasks
+// ============================================================================
+
+void TaskAwaiter::await_suspend(Task::Handle a_handle) {
+    m_handle = a_handle;
+    VoltScheduler::instance().enqueueTask(m_nLane, a_handle, m_nBudgetMs);
+}
+
+void VoltScheduler::enqueueTask(ETaskLane a_nLane, Task::Handle a_handle, double a_nBudgetMs) {
+    m_tasks[static_cast<int>(a_nLane)].push_back({a_handle, a_nBudgetMs});
+    requestLane(a_nLane);
+}
+
+void VoltScheduler::requestLane(ETaskLane a_nLane) {
+    switch (a_nLane) {
+        case ETaskLane::USER_BLOCKING:
+            requestFrame();
+            break;
+        case ETaskLane::NORMAL:
+            if (!m_bTaskPosted) {
+                m_bTaskPosted = true;
+                volt_js_post_task();
+            }
+            break;
+        case ETaskLane::IDLE:
+            if (!m_bIdleRequested) {
+                m_bIdleRequested = true;
+                volt_js_request_idle(VOLT_IDLE_TIMEOUT_MS);
+            }
+            break;
+    }
+}
+
+void VoltScheduler::runTasks(ETaskLane a_nLane, double a_nAvailableMs) {
+    std::vector<QueuedTask>& queue = m_tasks[static_cast<int>(a_nLane)];
+    if (a_nLane == ETaskLane::NORMAL) {
+        m_bTaskPosted = false;
+    } else if (a_nLane == ETaskLane::IDLE) {
+        m_bIdleRequested = false;
+    }
+    if (queue.empty() || !m_runningTasks.empty()) {
+        return; // Nothing to do, or called from inside a task
+    }
+
+    // Tasks that suspend again while this runs wait for the next call
+    m_runningTasks.swap(queue);
+
+    double nStart = emscripten_get_now();
+    double nLimitMs = a_nLane == ETaskLane::IDLE ? a_nAvailableMs : VOLT_TASK_SLICE_MS;
+    size_t nIdx = 0;
+    bool bResumed = false;
+    for (; nIdx < m_runningTasks.size(); ++nIdx) {
+        double nElapsedMs = emscripten_get_now() - nStart;
+        // At least one task per call, so a timed out idle callback still makes progress.
+        // nextFrame() tasks all run, they asked for this frame.
+        if (bResumed && a_nLane != ETaskLane::USER_BLOCKING && nElapsedMs >= nLimitMs) {
+            break;
+        }
+        QueuedTask& task = m_runningTasks[nIdx];
+        if (!task.handle) {
+            continue; // Cancelled by a task that ran before it
+        }
+        double nSliceMs = task.nBudgetMs;
+        if (a_nLane == ETaskLane::IDLE && nLimitMs > nElapsedMs) {
+            nSliceMs = std::min(nSliceMs, nLimitMs - nElapsedMs); // Not past the idle period
+        }
+        Task::Handle handle = task.handle;
+        task.handle = nullptr;
+        handle.promise().deadline = TaskDeadline{emscripten_get_now() + nSliceMs};
+        handle.resume(); // Runs to its next co_await, or ends and frees itself
+        bResumed = true;
+    }
+
+    // Tasks the time did not reach go first next time
+    std::vector<QueuedTask> leftover;
+    for (; nIdx < m_runningTasks.size(); ++nIdx) {
+        if (m_runningTasks[nIdx].handle) {
+            leftover.push_back(m_runningTasks[nIdx]);
+        }
+    }
+    m_runningTasks.clear();
+    if (!leftover.empty()) {
+        queue.insert(queue.begin(), leftover.begin(), leftover.end());
+    }
+    if (!queue.empty() && a_nLane != ETaskLane::USER_BLOCKING) {
+        requestLane(a_nLane); // nextFrame() tasks are requested by onAnimationFrame()
+    }
+}
+
+void VoltScheduler::cancelTasks(VoltEngine* a_pEngine) {
+    auto ownedBy = [a_pEngine](const QueuedTask& a_task) {
+        return a_task.handle && a_task.handle.promise().pOwner == a_pEngine;
+    };
+    for (std::vector<QueuedTask>& queue : m_tasks) {
+        for (QueuedTask& task : queue) {
+            if (ownedBy(task)) {
+                task.handle.destroy();
+                task.handle = nullptr;
+            }
+        }
+        queue.erase(std::remove_if(queue.begin(), queue.end(),
+            [](const QueuedTask& a_task) { return !a_task.handle; }), queue.end());
+    }
+    for (QueuedTask& task : m_runningTasks) {
+        if (ownedBy(task)) {
+            task.handle.destroy();
+            task.handle = nullptr;
+        }
+    }
+}
+
+// ============================================================================
+// Animations
+// ============================================================================
+
+void VoltScheduler::startAnimation(AnimatedBase* a_pAnimated) {
+    m_animations.push_back(a_pAnimated);
+    requestFrame();
+}
+
+void VoltScheduler::stopAnimation(AnimatedBase* a_pAnimated) {
+    m_animations.erase(std::remove(m_animations.begin(), m_animations.end(), a_pAnimated), m_animations.end());
+}
+
+void VoltScheduler::stepAnimations(double a_nTimestamp) {
+    // Writes go straight to the DOM: no render, no patch, only the bound properties
+    m_animations.erase(std::remove_if(m_animations.begin(), m_animations.end(),
+        [a_nTimestamp](AnimatedBase* a_pAnimated) { return !a_pAnimated->step(a_nTimestamp); }), m_animations.end());
+}
+
+} // namespace volt
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <emscripten.h>
+
+// Bridge from C++ to JS volt console: is any volt.on() prefix matching this category?
+EM_JS(int, volt_js_span_enabled, (const char* category), {
+    if (typeof window !== 'undefined' &&
+        window.volt &&
+        typeof window.volt._shouldSpan === 'function') {
+        return window.volt._shouldSpan(UTF8ToString(Number(category))) ? 1 : 0;
+    }
+    return 0;
+});
+
+// Bridge from C++ to JS volt console: one finished span (times from emscripten_get_now)
+EM_JS(void, volt_js_span,
+      (const char* category, const char* name, double start, double end, int nodes),
+{
+    if (typeof window !== 'undefined' &&
+        window.volt &&
+        typeof window.volt._recordSpan === 'function') {
+        window.volt._recordSpan(
+            UTF8ToString(Number(category)), UTF8ToString(Number(name)), start, end, nodes);
+    }
+});
+
+
+namespace volt {
+
+    enum class SpanCategory : int {
+        ENGINE    = 0, // doRender phases
+        COMPONENT = 1, // App::render and user-marked component renders
+        SUBTREE   = 2, // subtree syncs/adds visiting at least VOLT_SPAN_SUBTREE_THRESHOLD nodes
+        COUNT     = 3,
+    };
+
+    inline const char* toString(SpanCategory a_nCategory) {
+        switch (a_nCategory) {
+            case SpanCategory::ENGINE:    return "Volt>Span>Engine";
+            case SpanCategory::COMPONENT: return "Volt>Span>Component";
+            case SpanCategory::SUBTREE:   return "Volt>Span>Subtree";
+            default:                      return "Volt>Span";
+        }
+    }
+
+#ifdef VOLT_ENABLE_SPANS
+
+    // Minimum number of visited nodes for a subtree sync to get its own span
+    #ifndef VOLT_SPAN_SUBTREE_THRESHOLD
+    #define VOLT_SPAN_SUBTREE_THRESHOLD 50
+    #endif
+
+    // Enabled categories, refreshed from the JS filters once per frame
+    inline thread_local int g_nSpanEnabledMask = 0;
+
+    // Nodes visited by the reconciler, a subtree's size is the counter's delta over its span
+    inline thread_local int g_nSpanNodeCounter = 0;
+
+    inline void spansFrameBegin() {
+        g_nSpanEnabledMask = 0;
+        for (int i = 0; i < static_cast<int>(SpanCategory::COUNT); ++i) {
+            if (volt_js_span_enabled(toString(static_cast<SpanCategory>(i)))) {
+                g_nSpanEnabledMask |= 1 << i;
+            }
+        }
+    }
+
+    inline bool isSpanEnabled(SpanCategory a_nCategory) noexcept {
+        return (g_nSpanEnabledMask & (1 << static_cast<int>(a_nCategory))) != 0;
+    }
+
+    class Span {
+    public:
+        Span(SpanCategory a_nCategory, const char* a_sName) noexcept
+            : m_nCategory(a_nCategory),
+              m_sName(a_sName),
+              m_nStart(isSpanEnabled(a_nCategory) ? emscripten_get_now() : -1),
+              m_nStartNodes(g_nSpanNodeCounter) {}
+
+        ~Span() {
+            if (m_nStart < 0) {
+                return;
+            }
+            int nodes = g_nSpanNodeCounter - m_nStartNodes;
+            if (m_nCategory == SpanCategory::SUBTREE && nodes < VOLT_SPAN_SUBTREE_THRESHOLD) {
+                return; // Too small to be worth a span
+            }
+            volt_js_span(toString(m_nCategory), m_sName, m_nStart, emscripten_get_now(), nodes);
+        }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+    private:
+        SpanCategory m_nCategory;
+        const char* m_sName;
+        double m_nStart;
+        int m_nStartNodes;
+    };
+
+#endif // VOLT_ENABLE_SPANS
+
+} // namespace volt
+
+// ---- Public macros --------------------------------------------------------
+
+#ifdef VOLT_ENABLE_SPANS
+
+    #define VOLT_SPAN_CONCAT_IMPL(a, b) a##b
+    #define VOLT_SPAN_CONCAT(a, b) VOLT_SPAN_CONCAT_IMPL(a, b)
+
+    #define VOLT_SPANS_FRAME_BEGIN()    ::volt::spansFrameBegin()
+    #define VOLT_SPAN_NODE_VISITED()    (++::volt::g_nSpanNodeCounter)
+
+    // Scoped span, ends when the enclosing block ends. `name` must outlive the scope.
+    #define VOLT_SPAN(category, name) \
+        ::volt::Span VOLT_SPAN_CONCAT(volt_span_, __LINE__)((category), (name))
+
+    // Scoped span around a user component render, e.g. VOLT_SPAN_COMPONENT("Button");
+    #define VOLT_SPAN_COMPONENT(name) VOLT_SPAN(::volt::SpanCategory::COMPONENT, (name))
+
+#else
+
+    // Fully zero-cost when disabled: macros compile to nothing.
+
+    #define VOLT_SPANS_FRAME_BEGIN()    do {} while (0)
+    #define VOLT_SPAN_NODE_VISITED()    do {} while (0)
+    #define VOLT_SPAN(category, name)   do {} while (0)
+    #define VOLT_SPAN_COMPONENT(name)   do {} while (0)
+
+#endif
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <emscripten.h>
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+// Time a task slice may run when its lane gives no deadline of its own (nextFrame, yield)
+#ifndef VOLT_TASK_SLICE_MS
+#define VOLT_TASK_SLICE_MS 5.0
+#endif
+
+// Longest wait for an idle period before idle tasks run anyway
+#ifndef VOLT_IDLE_TIMEOUT_MS
+#define VOLT_IDLE_TIMEOUT_MS 100.0
+#endif
+
+// Resumes tasks of a lane from JS, bound by the app as Module.runVoltTasks(lane, budgetMs)
+EM_JS(void, volt_js_post_task, (), {
+    if (!Module.__voltTaskChannel) {
+        const channel = new MessageChannel();
+        channel.port1.onmessage = () => Module.runVoltTasks(1, 0);
+        Module.__voltTaskChannel = channel;
+    }
+    Module.__voltTaskChannel.port2.postMessage(0);
+});
+
+EM_JS(void, volt_js_request_idle, (double timeoutMs), {
+    if (typeof requestIdleCallback === "function") {
+        requestIdleCallback((deadline) => Module.runVoltTasks(2, deadline.timeRemaining()), { timeout: timeoutMs });
+    } else {
+        setTimeout(() => Module.runVoltTasks(2, 5), 1);
+    }
+});
+
+namespace volt {
+
+class VoltEngine;
+
+// ============================================================================
+// Task - Coroutine run by the VoltScheduler in slices
+// ============================================================================
+// Background work of an app, split with co_await on the awaitables below:
+//
+//   volt::Task Dashboard::aggregate() {
+//       volt::TaskDeadline deadline = co_await volt::idle(8.0);
+//       for (size_t i = 0; i < m_records.size(); ++i) {
+//           m_totals[m_records[i].nRegion] += m_records[i].nAmount;
+//           if (i % 4096 == 0 && deadline.expired()) {
+//               deadline = co_await volt::idle(8.0);
+//           }
+//       }
+//       invalidate(); // One render with the result
+//   }
+//
+// Started with App::spawn(), it runs synchronously up to its first co_await.
+// Suspended tasks belong to their engine and are destroyed with it. Calls to
+// invalidate() from any number of slices still render once, in the next frame.
+
+// Lanes, highest priority first
+enum class ETaskLane {
+    USER_BLOCKING,  // nextFrame(): requestAnimationFrame, before the engines render
+    NORMAL,         // yield(): MessageChannel, as soon as the browser handled pending input
+    IDLE,           // idle(): requestIdleCallback
+};
+
+// End of the slice a task was resumed for
+struct TaskDeadline {
+    double nEndMs = 0;
+
+    double remainingMs() const { return nEndMs - emscripten_get_now(); }
+    bool expired() const { return emscripten_get_now() >= nEndMs; }
+};
+
+class Task {
+public:
+    struct promise_type {
+        VoltEngine* pOwner = nullptr; // Set by VoltEngine::spawn()
+        TaskDeadline deadline;        // Set by the scheduler before each resume
+
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; } // Started by spawn()
+        std::suspend_never final_suspend() noexcept { return {}; }    // Frees itself when done
+        void return_void() {}
+        void unhandled_exception() {
+            emscripten_log(EM_LOG_ERROR, "Volt: unhandled exception in a Task");
+            std::terminate();
+        }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task(Task&& a_other) noexcept : m_handle(std::exchange(a_other.m_handle, nullptr)) {}
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (m_handle) {
+            m_handle.destroy(); // Never spawned
+        }
+    }
+
+    // Ownership of the coroutine, for VoltEngine::spawn()
+    Handle release() { return std::exchange(m_handle, nullptr); }
+
+private:
+    explicit Task(Handle a_handle) : m_handle(a_handle) {}
+
+    Handle m_handle;
+};
+
+// Suspends the task into a lane, see nextFrame(), yield() and idle()
+class TaskAwaiter {
+public:
+    TaskAwaiter(ETaskLane a_nLane, double a_nBudgetMs) : m_nLane(a_nLane), m_nBudgetMs(a_nBudgetMs) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Task::Handle a_handle);
+    TaskDeadline await_resume() const noexcept { return m_handle.promise().deadline; }
+
+private:
+    ETaskLane m_nLane;
+    double m_nBudgetMs;
+    Task::Handle m_handle;
+};
+
+// Resumes in the next animation frame, before the engines render
+inline TaskAwaiter nextFrame() { return TaskAwaiter(ETaskLane::USER_BLOCKING, VOLT_TASK_SLICE_MS); }
+
+// Resumes after the browser handled pending input and paint, without waiting for a frame
+inline TaskAwaiter yield() { return TaskAwaiter(ETaskLane::NORMAL, VOLT_TASK_SLICE_MS); }
+
+// Resumes in an idle period, for at most a_nBudgetMs (less if the period is shorter)
+inline TaskAwaiter idle(double a_nBudgetMs = VOLT_TASK_SLICE_MS) { return TaskAwaiter(ETaskLane::IDLE, a_nBudgetMs); }
+
+} // namespace volt
@@ -20,6 +20,10 @@
 //       debug: true,
 //     });
 //   </script>
+//
+// Several islands from one module (one engine per root, one shared frame):
+//   VoltBootstrap.start({ containerId: "island-a", rootId: "root-a" })
+//     .then(({ Module }) => VoltBootstrap.mount(Module, { containerId: "island-b", rootId: "root-b" }));
 
 (function (global) {
   "use strict";
@@ -117,6 +121,18 @@
     return passiveEventNames.has(eventName);
   }
 
+  // Non-bubbling events dispatched from the container instead of a listener per element.
+  // Keep in sync with attr::isDelegatedEvent() in Attrs.hpp.
+  const DELEGATED_EVENTS = {
+    // Reach the container in the capture phase
+    capture: ["focus", "blur", "scroll", "gotpointercapture", "lostpointercapture"],
+    // Synthesized from the bubbling over/out pair and its relatedTarget
+    enterLeave: [
+      { over: "mouseover", out: "mouseout", enter: "mouseenter", leave: "mouseleave", EventType: global.MouseEvent },
+      { over: "pointerover", out: "pointerout", enter: "pointerenter", leave: "pointerleave", EventType: global.PointerEvent },
+    ],
+  };
+
   function defaultPrint(text) {
     console.log("📝 Volt:", text);
   }
@@ -126,32 +142,26 @@
   }
 
   /**
-   * Starts a Volt app using the global VoltApp factory.
+   * Mounts one Volt engine on an already loaded module. Call it once per island;
+   * all engines of a module share one animation frame.
    *
+   * @param {Object} Module - Module returned by the VoltApp factory.
    * @param {Object} options
    * @param {string} [options.containerId="app-container"] - DOM element where events are listened from.
-   * @param {string} [options.rootId="root"] - DOM element where VoltRuntime mounts (currently implicit).
+   * @param {string} [options.rootId="root"] - DOM element the engine mounts on, also identifies the engine.
    * @param {boolean} [options.debug=true] - Enable debug logging.
    * @param {string[]} [options.events] - List of DOM event types to forward to Volt.
-   * @param {Object} [options.moduleOverrides] - Additional Emscripten module overrides.
    *
-   * @returns {Promise<{ Module, voltNamespace, destroy: () => void }>}
+   * @returns {{ destroy: () => void }}
    */
-  function start(options) {
+  function mount(Module, options) {
     const {
       containerId = "app-container",
       rootId = "root",
       debug = true,
       events = DEFAULT_EVENTS,
-      moduleOverrides = {},
     } = options || {};
 
-    if (typeof global.VoltApp !== "function") {
-      throw new Error(
-        "VoltApp factory not found. Make sure app.js (Emscripten output) is loaded before volt.js."
-      );
-    }
-
     const containerEl = document.getElementById(containerId);
     if (!containerEl) {
       throw new Error(
@@ -159,24 +169,14 @@
       );
     }
 
-    const rootEl = document.getElementById(rootId);
-    if (!rootEl) {
-      // Not fatal, but warn and continue (createVoltEngine currently uses hardcoded "root")
-      console.warn(
-        `VoltBootstrap: root element with id="${rootId}" not found. VoltRuntime will still create using its internal default.`
+    if (!document.getElementById(rootId)) {
+      throw new Error(
+        `VoltBootstrap: root element with id="${rootId}" not found.`
       );
     }
 
-    const mergedModuleConfig = Object.assign(
-      {
-        print: debug ? defaultPrint : function () {},
-        printErr: defaultPrintErr,
-      },
-      moduleOverrides
-    );
-
     if (debug) {
-      console.log("⚡ VoltBootstrap starting...");
+      console.log("⚡ VoltBootstrap mounting...");
       console.log("  containerId:", containerId);
       console.log("  rootId:", rootId);
       console.log("  events:", events.join(", "));
@@ -185,14 +185,81 @@
     // Will hold handler reference for cleanup
     const eventHandlers = [];
 
+    function addContainerListener(type, handler, options) {
+      containerEl.addEventListener(type, handler, options);
+      eventHandlers.push({ type, handler, options });
+    }
+
+    function invokeNonBubble(event) {
+      try {
+        Module.invokeVoltNonBubbleEvent(event);
+      } catch (err) {
+        console.error("❌ VoltBootstrap: error while invoking non-bubble event:", err);
+      }
+    }
+
+    // Elements from `from` up to the container that do not contain `other`, innermost first:
+    // the ones an over/out pair enters or leaves
+    function crossedElements(from, other) {
+      const crossed = [];
+      for (let el = from; el && el !== containerEl; el = el.parentNode) {
+        if (other && el.contains(other)) {
+          break;
+        }
+        crossed.push(el);
+      }
+      return crossed;
+    }
+
+    function dispatchSynthesized(EventType, type, sourceEvent, el) {
+      if (!el.__volt_node) {
+        return;
+      }
+      const event = new EventType(type, sourceEvent);
+      Object.defineProperty(event, "target", { value: el });
+      Object.defineProperty(event, "currentTarget", { value: el });
+      invokeNonBubble(event);
+    }
+
+    function attachDelegatedHandlers() {
+      const captureHandler = (event) => {
+        const target = event.target;
+        if (target && target !== containerEl && target.__volt_node) {
+          invokeNonBubble(event);
+        }
+      };
+      DELEGATED_EVENTS.capture.forEach((type) => {
+        addContainerListener(type, captureHandler, { capture: true, passive: type === "scroll" });
+      });
+
+      DELEGATED_EVENTS.enterLeave.forEach(({ over, out, enter, leave, EventType }) => {
+        if (typeof EventType !== "function") {
+          return;
+        }
+        // Enter goes outermost first, leave innermost first, as the browser dispatches them
+        addContainerListener(over, (event) => {
+          const entered = crossedElements(event.target, event.relatedTarget);
+          for (let i = entered.length - 1; i >= 0; --i) {
+            dispatchSynthesized(EventType, enter, event, entered[i]);
+          }
+        }, { passive: true });
+        addContainerListener(out, (event) => {
+          crossedElements(event.target, event.relatedTarget).forEach((el) => {
+            dispatchSynthesized(EventType, leave, event, el);
+          });
+        }, { passive: true });
+      });
+    }
+
     function attachEventHandlers(Module) {
       const genericHandler = (event) => {
         let target = event.target;
+        let flush = false; // A discrete event invalidated an engine
         while (target && target !== containerEl) {
-          if (target.__cpp_ptr) {
-            event.__volt_cpp_ptr = target.__cpp_ptr;
+          if (target.__volt_node) {
+            event.__volt_node = target.__volt_node;
             try {
-              Module.invokeVoltBubbleEvent(event);
+              flush = Module.invokeVoltBubbleEvent(event) === true || flush;
             } catch (err) {
               console.error("❌ VoltBootstrap: error while invoking bubble event:", err);
             }
@@ -202,35 +269,47 @@
           }
           target = target.parentNode;
         }
+        flushSync(flush);
       };
 
+      // Renders now what discrete input invalidated, one flush per event after every handler ran
+      function flushSync(flush) {
+        if (!flush || typeof Module.flushVoltSync !== "function") {
+          return;
+        }
+        try {
+          Module.flushVoltSync();
+        } catch (err) {
+          console.error("❌ VoltBootstrap: error while flushing a render:", err);
+        }
+      }
+
       function makeFocusInOutHandlers() {
         /** @type {{ type: 'in'|'out', event: FocusEvent }[]} */
         const pending = [];
         let processing = false;
 
         function processFocusIn(event) {
-          // We’re entering / changing focus within this container
-          Module.clearVoltFocussedElements();
-
-          // Focus-register every node up to the container
+          // We’re entering / changing focus within this container: one call with the
+          // nearest Volt element, the engine flags it and its ancestors
           let target = event.target;
-          while (target && target !== containerEl) {
-            try {
-              Module.addVoltFocussedElement(target);
-            } catch (err) {
-              console.error("❌ VoltBootstrap: error in focusin focus-register handler:", err);
-            }
+          while (target && target !== containerEl && !target.__volt_node) {
             target = target.parentNode;
           }
+          try {
+            Module.setVoltFocussedNode(rootId, target && target.__volt_node ? target.__volt_node : 0);
+          } catch (err) {
+            console.error("❌ VoltBootstrap: error in focusin focus-register handler:", err);
+          }
 
           // Call bubble event handlers up to the container
           target = event.target;
+          let flush = false;
           while (target && target !== containerEl) {
-            if (target.__cpp_ptr) {
-              event.__volt_cpp_ptr = target.__cpp_ptr;
+            if (target.__volt_node) {
+              event.__volt_node = target.__volt_node;
               try {
-                Module.invokeVoltBubbleEvent(event);
+                flush = Module.invokeVoltBubbleEvent(event) === true || flush;
               } catch (err) {
                 console.error("❌ VoltBootstrap: error in focusin handler:", err);
               }
@@ -240,6 +319,7 @@
             }
             target = target.parentNode;
           }
+          flushSync(flush);
         }
 
         function processFocusOut(event) {
@@ -251,7 +331,7 @@
 
           // Focus has left the container entirely (or to null / browser chrome / other region).
           try {
-            Module.clearVoltFocussedElements();
+            Module.clearVoltFocussedElements(rootId);
           } catch (err) {
             console.error("❌ VoltBootstrap: error in focusout handler:", err);
           }
@@ -290,27 +370,85 @@
       const { focusInHandler, focusOutHandler } = makeFocusInOutHandlers();
       events.forEach((type) => {
         const handler = type === "focusin" ? focusInHandler : type === "focusout" ? focusOutHandler : genericHandler;
-        containerEl.addEventListener(type, handler, { passive: isPassiveEvent(type) });
-        eventHandlers.push({ type, handler });
+        addContainerListener(type, handler, { passive: isPassiveEvent(type) });
       });
+      attachDelegatedHandlers();
 
       if (debug) {
         console.log(
-          `✅ VoltBootstrap: attached ${events.length} event listeners to #${containerId}`
+          `✅ VoltBootstrap: attached ${eventHandlers.length} event listeners to #${containerId}`
         );
       }
     }
 
     function detachEventHandlers() {
-      eventHandlers.forEach(({ type, handler }) => {
-        containerEl.removeEventListener(type, handler);
+      eventHandlers.forEach(({ type, handler, options }) => {
+        containerEl.removeEventListener(type, handler, options);
       });
       eventHandlers.length = 0;
     }
 
+    if (typeof Module.createVoltEngine !== "function") {
+      throw new Error(
+        "Module.createVoltEngine() not found. Check your Emscripten/Volt bindings."
+      );
+    }
+
+    attachEventHandlers(Module);
+
+    // One engine per root id, rendered by the module's shared frame scheduler
+    Module.createVoltEngine(rootId);
+
+    if (debug) {
+      console.log(`✨ Volt app mounted on #${rootId}!`);
+    }
+
+    function destroy() {
+      if (debug) {
+        console.log(`🧹 VoltBootstrap: destroying app instance on #${rootId}...`);
+      }
+      detachEventHandlers();
+      if (typeof Module.destroyVoltEngine === "function") {
+        Module.destroyVoltEngine(rootId);
+      }
+    }
+
+    return { destroy };
+  }
+
+  /**
+   * Starts a Volt app using the global VoltApp factory.
+   *
+   * @param {Object} options - Same as mount(), plus:
+   * @param {Object} [options.moduleOverrides] - Additional Emscripten module overrides.
+   *
+   * @returns {Promise<{ Module, voltNamespace, destroy: () => void }>}
+   */
+  function start(options) {
+    const {
+      containerId = "app-container",
+      rootId = "root",
+      debug = true,
+      moduleOverrides = {},
+    } = options || {};
+
+    if (typeof global.VoltApp !== "function") {
+      throw new Error(
+        "VoltApp factory not found. Make sure app.js (Emscripten output) is loaded before volt.js."
+      );
+    }
+
+    const mergedModuleConfig = Object.assign(
+      {
+        print: debug ? defaultPrint : function () {},
+        printErr: defaultPrintErr,
+      },
+      moduleOverrides
+    );
+
     function showErrorOverlay(message) {
       try {
-        const root = rootEl || containerEl;
+        const root = document.getElementById(rootId) || document.getElementById(containerId);
         root.innerHTML =
           '<div style="color: red; padding: 20px;">Failed to load Volt app: ' +
           String(message) +
@@ -335,29 +473,7 @@
           }
         }
 
-        attachEventHandlers(Module);
-
-        if (typeof Module.createVoltEngine !== "function") {
-          throw new Error(
-            "Module.createVoltEngine() not found. Check your Emscripten/Volt bindings."
-          );
-        }
-
-        // Currently createVoltEngine creates VoltRuntime internally.
-        Module.createVoltEngine(rootId);
-
-        if (debug) {
-          console.log("✨ Volt app mounted!");
-        }
-
-        function destroy() {
-          if (debug) {
-            console.log("🧹 VoltBootstrap: destroying app instance...");
-          }
-          detachEventHandlers();
-          // NOTE: If/when Volt exposes a runtime destroy/unmount API,
-          // it should be called here.
-        }
+        const { destroy } = mount(Module, options);
 
         return { Module, voltNamespace, destroy };
       })
@@ -371,6 +487,7 @@
   // Expose as a small global namespace
   global.VoltBootstrap = {
     start,
+    mount,
   };
 })(window);
 
@@ -456,6 +573,91 @@
     // Load persisted settings once on init
     loadState();
 
+    // Ring buffer of the last profiled frames (filled only by builds with VOLT_ENABLE_PROFILER)
+    const MAX_FRAMES = 240;
+    const frameRing = new Array(MAX_FRAMES);
+    let frameCount = 0; // total frames recorded, ring index = frameCount % MAX_FRAMES
+
+    function lastFrames(count) {
+        const available = Math.min(frameCount, MAX_FRAMES);
+        const n = Math.min(count == null ? available : count, available);
+        const out = [];
+        for (let i = frameCount - n; i < frameCount; i++) {
+            out.push(frameRing[i % MAX_FRAMES]);
+        }
+        return out;
+    }
+
+    // Chrome trace-event buffer of the last spans (filled only by builds with VOLT_ENABLE_SPANS)
+    const MAX_TRACE_EVENTS = 20000;
+    let traceEvents = [];
+
+    const TIME_FIELDS = ["renderMs", "buildMs", "walkMs", "commitMs", "totalMs"];
+    const COUNT_FIELDS = [
+        "nodesCreated", "nodesReused", "nodesMoved", "nodesRemoved", "textsUpdated",
+        "attrsSet", "attrsRemoved", "listenersAdded", "listenersRemoved",
+    ];
+
+    // Serialized DOM patch of one frame (VOLT_ENABLE_PATCH_BUFFER, see EPatchOp in VoltPatch.hpp):
+    //   ops      Int32Array, opcode then operands per record
+    //   handles  Uint32Array, handle ids; resolve(id) returns the node, style, classList or value
+    //   strings  Uint8Array, UTF-8 arena, str operands are (offset, length) into it
+    //   names    Array, attribute/property/event names by name id
+    // Only reads what it is given, so a patch copied off the wasm heap (posted by a worker) applies alike.
+    const utf8 = new TextDecoder();
+
+    function applyPatch(patch, resolve) {
+        const { ops, handles, strings, names } = patch;
+        // TextDecoder rejects views of a SharedArrayBuffer (pthread builds), those are copied first
+        const shared = typeof SharedArrayBuffer !== "undefined" && strings.buffer instanceof SharedArrayBuffer;
+        const h = (idx) => resolve(handles[idx]);
+        const name = (id) => names[id];
+        const str = (off, len) => {
+            if (len < 16) {
+                let s = "";
+                for (let k = off; k < off + len; k++) {
+                    const c = strings[k];
+                    if (c >= 0x80) return utf8.decode(strings.slice(off, off + len));
+                    s += String.fromCharCode(c);
+                }
+                return s;
+            }
+            return utf8.decode(shared ? strings.slice(off, off + len) : strings.subarray(off, off + len));
+        };
+
+        let i = 0;
+        const end = ops.length;
+        while (i < end) {
+            const a = ops[i + 1], b = ops[i + 2], c = ops[i + 3], d = ops[i + 4];
+            switch (ops[i]) {
+                case 1: h(a).setAttribute(name(b), str(c, d)); i += 5; break;
+                case 2: { const e = h(a), n = name(b), v = str(c, d); if (e[n] !== v) e[n] = v; i += 5; break; }
+                case 3: h(a)[name(b)] = c !== 0; i += 4; break;
+                case 4: h(a).toggleAttribute(name(b), c !== 0); i += 4; break;
+                case 5: h(a).style.cssText = str(b, c); i += 4; break;
+                case 6: h(a).removeAttribute(name(b)); i += 3; break;
+                case 7: h(a).setProperty(str(b, c), str(d, ops[i + 5])); i += 6; break;
+                case 8: h(a).removeProperty(str(b, c)); i += 4; break;
+                case 9: h(a).add(str(b, c)); i += 4; break;
+                case 10: h(a).remove(str(b, c)); i += 4; break;
+                case 11: h(a).nodeValue = str(b, c); i += 4; break;
+                case 12: h(a).appendChild(h(b)); i += 3; break;
+                case 13: h(a).insertBefore(h(b), h(c)); i += 4; break;
+                case 14: h(a).removeChild(h(b)); i += 3; break;
+                case 15: h(a).addEventListener(name(b), h(c)); i += 4; break;
+                case 16: h(a).removeEventListener(name(b), h(c)); i += 4; break;
+                case 17: h(a).setAttribute(name(b), h(c)); i += 4; break;
+                case 18: { const e = h(a), n = name(b), v = h(c); if (e[n] !== v) e[n] = v; i += 4; break; }
+                case 19: h(a).style.cssText = h(b); i += 3; break;
+                case 20: h(a).nodeValue = h(b); i += 3; break;
+                case 21: { const e = h(a), n = name(b), v = Number(str(c, d)); if (e[n] !== v) e[n] = v; i += 5; break; }
+                default:
+                    console.error("Volt: unknown patch op " + ops[i]);
+                    return;
+            }
+        }
+    }
+
     // Public API object
     const api = {
         /**
@@ -515,6 +717,66 @@
             console.log(`✔ Volt log level = ${lvl.toUpperCase()}`);
         },
 
+        /**
+         * Summary (avg / max / total) of the buffered profiler frames.
+         * Requires a build with -DVOLT_ENABLE_PROFILER.
+         */
+        stats() {
+            const frames = lastFrames();
+            if (frames.length === 0) {
+                console.log("No Volt frames recorded. Build with -DVOLT_ENABLE_PROFILER to enable the profiler.");
+                return null;
+            }
+
+            const summary = {};
+            for (const field of TIME_FIELDS.concat(COUNT_FIELDS)) {
+                let total = 0;
+                let max = 0;
+                for (const f of frames) {
+                    total += f[field];
+                    if (f[field] > max) max = f[field];
+                }
+                summary[field] = {
+                    avg: +(total / frames.length).toFixed(3),
+                    max: +max.toFixed(3),
+                    total: +total.toFixed(3),
+                };
+            }
+
+            console.log(`Volt profiler: ${frames.length} frame(s)`);
+            console.table(summary);
+            return summary;
+        },
+
+        /**
+         * Last `count` profiled frames (all buffered frames if omitted), oldest first.
+         */
+        frames(count = null) {
+            const frames = lastFrames(count);
+            if (frames.length > 0) {
+                console.table(frames);
+            }
+            return frames;
+        },
+
+        /**
+         * Chrome trace-event JSON of the buffered spans, loadable in Perfetto or
+         * the Performance panel. Spans are also emitted live as performance.measure().
+         * Requires a build with -DVOLT_ENABLE_SPANS and a volt.on() prefix
+         * matching the span category, e.g. volt.on("Volt>Span").
+         */
+        trace() {
+            return { traceEvents: traceEvents.slice(), displayTimeUnit: "ms" };
+        },
+
+        /**
+         * Drop all buffered spans.
+         */
+        clearTrace() {
+            traceEvents = [];
+            console.log("✔ Volt trace buffer cleared.");
+        },
+
         /**
          * Print all commands
          */
@@ -526,6 +788,10 @@ volt.on("<category>")     Enable a category (prefix match)
 volt.off("<category>")    Disable category
 volt.show()               Show all enabled categories
 volt.level("<level>")     Set minimum level (trace,debug,info,warn,error)
+volt.stats()              Profiler summary of the last frames
+volt.frames(<count>)      Profiler records of the last frames
+volt.trace()              Chrome trace-event JSON of the recorded spans
+volt.clearTrace()         Drop recorded spans
 volt.help()               Show this help
 
 Current:
@@ -535,6 +801,7 @@ Current:
 Example:
   volt.on("Volt>DiffPatch")
   volt.level("debug")
+  volt.on("Volt>Span")      (User Timing spans, with -DVOLT_ENABLE_SPANS)
 
 =============================================================`
             );
@@ -550,6 +817,47 @@ Example:
             return false;
         },
 
+        // INTERNAL: used by C++ span bridge, same prefix filters as logs but no level
+        _shouldSpan(category) {
+            for (const prefix of enabled) {
+                if (category.startsWith(prefix)) return true;
+            }
+            return false;
+        },
+
+        // INTERNAL: used by C++ span bridge
+        _recordSpan(category, name, start, end, nodes) {
+            const detail = { category, nodes };
+            try {
+                performance.measure(name, { start, end, detail });
+            } catch (e) {
+                // User Timing Level 3 not available, the trace buffer still gets the span
+            }
+
+            if (traceEvents.length >= MAX_TRACE_EVENTS) {
+                traceEvents.splice(0, traceEvents.length - MAX_TRACE_EVENTS + 1);
+            }
+            traceEvents.push({
+                name,
+                cat: category,
+                ph: "X",
+                ts: Math.round((performance.timeOrigin + start) * 1000),
+                dur: Math.round((end - start) * 1000),
+                pid: 1,
+                tid: 1,
+                args: detail,
+            });
+        },
+
+        // INTERNAL: used by C++ profiler bridge
+        _recordFrame(frame) {
+            frameRing[frameCount % MAX_FRAMES] = frame;
+            frameCount++;
+        },
+
+        // INTERNAL: used by C++ patch bridge, and for patches posted by a worker
+        _applyPatch: applyPatch,
+
         // INTERNAL: used by C++ logging bridge
         _print(level, category, indent, message) {
             const lvlName = levelNames[level] || "LOG";